@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/BufferTest"
+  "/root/repo/BufferTest.pdb"
+  "CMakeFiles/BufferTest.dir/example/main_buffer_test.cpp.o"
+  "CMakeFiles/BufferTest.dir/example/main_buffer_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BufferTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
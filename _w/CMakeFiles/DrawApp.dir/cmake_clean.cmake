@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/DrawApp"
+  "/root/repo/DrawApp.pdb"
+  "CMakeFiles/DrawApp.dir/example/main_draw_app.cpp.o"
+  "CMakeFiles/DrawApp.dir/example/main_draw_app.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DrawApp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
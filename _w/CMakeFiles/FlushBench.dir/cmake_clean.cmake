@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/FlushBench"
+  "/root/repo/FlushBench.pdb"
+  "CMakeFiles/FlushBench.dir/example/main_flush_bench.cpp.o"
+  "CMakeFiles/FlushBench.dir/example/main_flush_bench.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/FlushBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/ItemApp"
+  "/root/repo/ItemApp.pdb"
+  "CMakeFiles/ItemApp.dir/example/main_item_app.cpp.o"
+  "CMakeFiles/ItemApp.dir/example/main_item_app.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ItemApp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
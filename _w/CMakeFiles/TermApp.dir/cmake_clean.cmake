@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/TermApp"
+  "/root/repo/TermApp.pdb"
+  "CMakeFiles/TermApp.dir/example/main_term_app.cpp.o"
+  "CMakeFiles/TermApp.dir/example/main_term_app.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TermApp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/cx_buffer.cpp" "CMakeFiles/cx_core.dir/src/cx_buffer.cpp.o" "gcc" "CMakeFiles/cx_core.dir/src/cx_buffer.cpp.o.d"
+  "/root/repo/src/cx_caps.cpp" "CMakeFiles/cx_core.dir/src/cx_caps.cpp.o" "gcc" "CMakeFiles/cx_core.dir/src/cx_caps.cpp.o.d"
+  "/root/repo/src/cx_color.cpp" "CMakeFiles/cx_core.dir/src/cx_color.cpp.o" "gcc" "CMakeFiles/cx_core.dir/src/cx_color.cpp.o.d"
+  "/root/repo/src/cx_device.cpp" "CMakeFiles/cx_core.dir/src/cx_device.cpp.o" "gcc" "CMakeFiles/cx_core.dir/src/cx_device.cpp.o.d"
+  "/root/repo/src/cx_pane.cpp" "CMakeFiles/cx_core.dir/src/cx_pane.cpp.o" "gcc" "CMakeFiles/cx_core.dir/src/cx_pane.cpp.o.d"
+  "/root/repo/src/cx_renderer.cpp" "CMakeFiles/cx_core.dir/src/cx_renderer.cpp.o" "gcc" "CMakeFiles/cx_core.dir/src/cx_renderer.cpp.o.d"
+  "/root/repo/src/cx_screen.cpp" "CMakeFiles/cx_core.dir/src/cx_screen.cpp.o" "gcc" "CMakeFiles/cx_core.dir/src/cx_screen.cpp.o.d"
+  "/root/repo/src/cx_task.cpp" "CMakeFiles/cx_core.dir/src/cx_task.cpp.o" "gcc" "CMakeFiles/cx_core.dir/src/cx_task.cpp.o.d"
+  "/root/repo/src/cx_util.cpp" "CMakeFiles/cx_core.dir/src/cx_util.cpp.o" "gcc" "CMakeFiles/cx_core.dir/src/cx_util.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
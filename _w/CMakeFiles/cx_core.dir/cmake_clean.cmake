@@ -0,0 +1,27 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cx_core.dir/src/cx_buffer.cpp.o"
+  "CMakeFiles/cx_core.dir/src/cx_buffer.cpp.o.d"
+  "CMakeFiles/cx_core.dir/src/cx_caps.cpp.o"
+  "CMakeFiles/cx_core.dir/src/cx_caps.cpp.o.d"
+  "CMakeFiles/cx_core.dir/src/cx_color.cpp.o"
+  "CMakeFiles/cx_core.dir/src/cx_color.cpp.o.d"
+  "CMakeFiles/cx_core.dir/src/cx_device.cpp.o"
+  "CMakeFiles/cx_core.dir/src/cx_device.cpp.o.d"
+  "CMakeFiles/cx_core.dir/src/cx_pane.cpp.o"
+  "CMakeFiles/cx_core.dir/src/cx_pane.cpp.o.d"
+  "CMakeFiles/cx_core.dir/src/cx_renderer.cpp.o"
+  "CMakeFiles/cx_core.dir/src/cx_renderer.cpp.o.d"
+  "CMakeFiles/cx_core.dir/src/cx_screen.cpp.o"
+  "CMakeFiles/cx_core.dir/src/cx_screen.cpp.o.d"
+  "CMakeFiles/cx_core.dir/src/cx_task.cpp.o"
+  "CMakeFiles/cx_core.dir/src/cx_task.cpp.o.d"
+  "CMakeFiles/cx_core.dir/src/cx_util.cpp.o"
+  "CMakeFiles/cx_core.dir/src/cx_util.cpp.o.d"
+  "libcx_core.a"
+  "libcx_core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cx_core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -2,7 +2,6 @@
 
 #include <iostream>
 #include <string>
-#include <thread>
 #include <chrono>
 #include <cmath>
 
@@ -11,34 +10,39 @@ using namespace std::chrono_literals;
 int main()
 {
     // 1. 초기 설정
+    cx::Capabilities::Probe(); // 동기화 출력을 지원하면 프레임 단위로 갱신
     cx::Device::EnableMouse(false); // 마우스 불필요
 
     cx::Screen::SetBackColor(cx::Color::Black); // 배경색을 검정으로 설정
     cx::Screen::Clear();                        // 해당 배경색으로 화면 전체 지우기
     std::cout << std::flush;                    // 즉시 반영
 
-    cx::Buffer buffer; // 가상 버퍼 생성
+    // 출력은 렌더 스레드가 담당 (터미널 출력이 느려도 입력 처리와 다음 프레임 그리기는 막히지 않음)
+    cx::Renderer renderer;
 
     int x = 2, y = 2;
     int dx = 1, dy = 1;
     long long frame_count = 0;
     bool is_running = true;
 
+    // 애니메이션이므로 고정 60 FPS로 FRAME_EVENT를 계속 받음 (sleep_for 불필요)
+    cx::Device::SetFrameRate(60, cx::FramePacing::CONTINUOUS);
+
     while (is_running)
     {
         // --- [입력 처리] ---
-        // 0ms 대기로 입력 확인 (Non-blocking)
-        if (auto input = cx::Device::GetInput(1ms); input) {
-            auto event = cx::Device::Inspect(input);
-            if (event.code == cx::DeviceInputCode::q || event.code == cx::DeviceInputCode::ESC) {
-                is_running = false;
-            }
+        // 키 입력과 프레임 틱을 같은 대기에서 받음
+        auto event = cx::Device::GetInput();
+        if (event.code == cx::DeviceInputCode::q || event.code == cx::DeviceInputCode::ESC) {
+            is_running = false;
         }
+        if (!event.IsFrame()) continue;
 
         // --- [상태 업데이트] ---
         auto size = cx::Screen::GetSize();
 
-        // 1. 버퍼 리사이즈 & 초기화
+        // 1. 버퍼 리사이즈 & 초기화 (Submit() 때마다 버퍼가 바뀌므로 매 프레임 받아 옴)
+        cx::Buffer& buffer = renderer.GetBuffer();
         buffer.Resize(size.cols, size.rows);
         buffer.Clear(cx::Color::Black);
 
@@ -68,20 +72,21 @@ int main()
         buffer.DrawBox(x, y, 24, 12, box_color, cx::Color{20,20,20});
         buffer.DrawString(x + 8, y + 5, "NO FLICKER", cx::Color::White, cx::Color::Black);
 
-        // 5. 프레임 카운터 및 안내
-        std::string info = " Frame: " + std::to_string(frame_count) + " | Press [Q] to Quit ";
+        // 5. 프레임 카운터 및 안내 (Skipped: 렌더링이 늦어 건너뛴 틱 수, Dropped: 출력이 늦어 버려진 프레임 수)
+        std::string info = " Frame: " + std::to_string(frame_count) +
+                           " | Skipped: " + std::to_string(event.frame_skipped) +
+                           " | Dropped: " + std::to_string(renderer.GetDroppedFrames()) + " | Press [Q] to Quit ";
         buffer.DrawString(2, 0, info, cx::Color::Yellow, cx::Color::Blue);
 
         // --- [렌더링] ---
-        // 여기서 변경된 픽셀만 계산되어 터미널로 전송됩니다.
-        buffer.Flush();
+        // 렌더 스레드가 변경된 픽셀만 계산하여 터미널로 전송합니다. (대기 없이 리턴)
+        renderer.Submit();
 
         frame_count++;
-
-        // 약 60 FPS 조절 (너무 빠르면 눈이 아플 수 있음)
-        std::this_thread::sleep_for(16ms);
     }
 
+    renderer.Stop(); // 남은 프레임 출력 후 렌더 스레드 종료 (이후 화면 직접 출력)
+
     cx::Screen::Clear();
     cx::Screen::ResetColor();
     std::cout << "Test Finished." << std::endl;
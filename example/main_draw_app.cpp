@@ -9,6 +9,7 @@
 #include <sstream>
 #include <functional>
 #include <iomanip>
+#include <array>
 
 using namespace std::chrono_literals;
 
@@ -36,23 +37,37 @@ public:
 
     void Run()
     {
+        cx::Capabilities::Probe(); // 색상 수, 동기화 출력 등 확인 (두 번째 실행부터는 캐시 사용)
+
         cx::Device::EnableMouse( true );
+        cx::Device::EnablePaste( true ); // 색상 코드 붙여넣기를 한 번에 받음
+        cx::Device::EnableKittyKeyboard( true ); // 지원 터미널에서는 ESC 판별 대기 없이 즉시 반응
+
+        // 선 보간에 중간 좌표가 모두 필요하므로 드래그는 병합하지 않음 (크기 변경만 병합)
+        cx::Device::SetCoalesce( cx::COALESCE_RESIZE );
 
         // 초기 검은 화면 설정
         cx::Screen::SetBackColor(cx::Color::Black);
         cx::Screen::Clear();
 
+        // 입력이 있을 때만 다시 그림 (최대 60 FPS, 입력이 없으면 대기)
+        cx::Device::SetFrameRate( 60 );
+
         // 최초 1회 렌더링
         Render();
 
         while( state_.is_running )
         {
-            // 입력이 있거나 렌더링 요청이 있을 때만 루프
-            if( auto input_opt = cx::Device::GetInput( 10ms ); input_opt ){
-                ProcessInput( cx::Device::Inspect( input_opt ) );
+            // 쌓인 입력(드래그 샘플 등)을 한 번에 모두 처리하고, 렌더링은 프레임 시점에 한 번만
+            size_t count = cx::Device::GetEvents( events_ );
+            for( size_t i = 0; i < count && state_.is_running; ++i ){
+                if( events_[i].IsFrame() ) {
+                    Render();
+                    continue;
+                }
+                ProcessInput( events_[i] );
+                cx::Device::RequestFrame();
             }
-
-            Render();
         }
 
         Cleanup();
@@ -89,6 +104,7 @@ private:
 
     // --- Member Variables ---
     AppState state_;
+    std::array<cx::Device::Event, 128> events_; // 입력 묶음 수신 버퍼
 
     // [New] Rendering Core
     cx::Buffer screen_buffer_;
@@ -104,9 +120,14 @@ private:
 
     void Cleanup()
     {
+        cx::Device::EnableKittyKeyboard( false );
+        cx::Device::EnablePaste( false );
         cx::Device::EnableMouse( false );
         cx::Screen::ResetColor();
         cx::Screen::Clear();
+
+        // 남은 화면 출력을 먼저 모두 씀 (이후 std::cout 출력과 섞이지 않도록)
+        cx::Screen::DrainOutput( std::chrono::seconds( 1 ) );
         std::cout << "DrawApp Terminated." << std::endl;
     }
 
@@ -273,6 +294,14 @@ private:
         else if ( event.code == cx::DeviceInputCode::BACKSPACE ) {
             if ( !state_.input_buffer.empty() ) state_.input_buffer.pop_back();
         }
+        else if ( event.IsPaste() ) {
+            // 붙여넣은 색상 코드(#RRGGBB 등)에서 16진수 문자만 추림
+            for ( char c : event.GetPasteText() ) {
+                if ( !isxdigit( (unsigned char)c ) ) continue;
+                if ( state_.input_buffer.length() >= 6 ) break;
+                state_.input_buffer += (char)toupper(c);
+            }
+        }
         else {
             std::string key_str = cx::Device::KeyToString( event.code );
             if ( key_str.length() == 1 && isxdigit(key_str[0]) ) {
@@ -519,8 +548,9 @@ void DrawBottomBar()
         DrawTopBar();
         DrawBottomBar();
 
-        // 6. 최종 출력
+        // 6. 최종 출력 (터미널이 다 받지 못했으면 다음 프레임에 이어서 출력)
         screen_buffer_.Flush();
+        if( cx::Screen::HasPendingOutput() ) cx::Device::RequestFrame();
     }
 };
 
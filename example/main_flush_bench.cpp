@@ -0,0 +1,91 @@
+#include "ConsoleX.hpp"
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+
+// Flush() 변경 셀 검색 벤치마크 (SIMD 비교 vs 셀마다 operator!=)
+// - 500 x 200 버퍼에 매 프레임 같은 배경을 다시 그리고 일부만 바꾼 뒤 Flush() 시간을 잽니다.
+// - 출력은 버려야 시간이 터미널 속도에 좌우되지 않습니다.
+//
+// 실행: ./FlushBench > /dev/null           (기본 300 프레임)
+//       ./FlushBench 1000 > /dev/null      (프레임 수 지정)
+
+namespace
+{
+    constexpr int WIDTH  = 500;
+    constexpr int HEIGHT = 200;
+
+    // 모든 행에서 바뀌는 셀이 있는 경우 (셀 검색 비용이 그대로 드러남)
+    void DrawEveryRow(cx::Buffer& buffer, int frame)
+    {
+        buffer.Clear(cx::Color::Black);
+        for (int y = 0; y < HEIGHT; ++y) {
+            buffer.DrawString(0, y, std::string(400, '.'), cx::Color(200, 200, 200), cx::Color::Black);
+            buffer.DrawString((frame + y * 7) % WIDTH, y, "#", cx::Color::White, cx::Color::Blue);
+        }
+    }
+
+    // 대부분 그대로이고 한 곳만 움직이는 경우 (일반적인 UI)
+    void DrawMostlyStatic(cx::Buffer& buffer, int frame)
+    {
+        buffer.Clear(cx::Color::Black);
+        for (int y = 0; y < HEIGHT; y += 2) {
+            buffer.DrawString(0, y, std::string(400, '.'), cx::Color(200, 200, 200), cx::Color::Black);
+        }
+        buffer.DrawString(frame % 400, HEIGHT / 2, "MOVING", cx::Color::White, cx::Color::Blue);
+    }
+
+    // 프레임당 평균 Flush() 시간 (us)
+    double MeasureFlush(void (*draw)(cx::Buffer&, int), bool simd, int frames)
+    {
+        cx::Buffer::SetSimdDiff(simd);
+
+        cx::Buffer buffer;
+        buffer.Resize(WIDTH, HEIGHT);
+        draw(buffer, 0);
+        buffer.Flush();
+
+        double total_us = 0;
+        for (int frame = 1; frame <= frames; ++frame) {
+            draw(buffer, frame);
+
+            auto start = std::chrono::steady_clock::now();
+            buffer.Flush();
+            total_us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+            while (!cx::Screen::DrainOutput(std::chrono::milliseconds(100))) {}
+        }
+        return total_us / frames;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int frames = (argc > 1) ? std::atoi(argv[1]) : 300;
+    if (frames <= 0) frames = 300;
+
+    struct Scenario { const char* name; void (*draw)(cx::Buffer&, int); };
+    const Scenario scenarios[] = {
+        { "every row changes", DrawEveryRow     },
+        { "mostly static",     DrawMostlyStatic },
+    };
+
+    cx::Buffer::SetSimdDiff(true);
+    std::cerr << std::fixed << std::setprecision(1);
+    std::cerr << "Flush benchmark " << WIDTH << "x" << HEIGHT << ", " << frames << " frames, scan = "
+              << cx::Buffer::GetDiffScanName() << "\n";
+
+    for (const auto& scenario : scenarios) {
+        double cell_us = MeasureFlush(scenario.draw, false, frames);
+        double simd_us = MeasureFlush(scenario.draw, true, frames);
+
+        std::cerr << "  " << scenario.name << ": operator!= " << cell_us << " us, SIMD " << simd_us
+                  << " us (x" << (simd_us > 0 ? cell_us / simd_us : 0) << ")\n";
+    }
+
+    cx::Buffer::SetSimdDiff(true);
+    return 0;
+}
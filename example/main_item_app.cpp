@@ -125,7 +125,6 @@ class InventoryApp {
     enum class ViewMode { NORMAL, MAXIMIZED };
 
     bool is_running = true;
-    bool need_render = true;
     ViewMode view_mode = ViewMode::NORMAL;
 
     std::vector<Inventory> inventories;
@@ -169,22 +168,29 @@ public:
     }
 
     void Run() {
+        cx::Capabilities::Probe();
         cx::Device::EnableMouse(true);
 
+        // 창/아이템 드래그는 최신 위치만 필요하므로, 밀린 드래그 이벤트는 합쳐서 받음
+        cx::Device::SetCoalesce(cx::COALESCE_DRAG | cx::COALESCE_RESIZE);
+
         cx::Screen::SetBackColor(cx::Color::Black); // 배경색을 검정으로 설정
         cx::Screen::Clear();                        // 해당 배경색으로 화면 전체 지우기
         std::cout << std::flush;                    // 즉시 반영
 
-        while(is_running) {
-            if(auto input = cx::Device::GetInput(10ms); input) {
-                ProcessInput(cx::Device::Inspect(input));
-                need_render = true;
-            }
+        // 입력이 없으면 깨어나지 않고, 입력이 몰려도 최대 60 FPS로만 그림
+        cx::Device::SetFrameRate(60);
+        cx::Device::RequestFrame();
 
-            if (need_render) {
+        while(is_running) {
+            auto event = cx::Device::GetInput();
+            if (event.IsFrame()) {
                 Render();
-                need_render = false;
+                continue;
             }
+
+            ProcessInput(event);
+            cx::Device::RequestFrame();
         }
         cx::Device::EnableMouse(false);
         cx::Screen::Clear();
@@ -472,6 +478,7 @@ private:
             screen_buffer.DrawString(x, y+2, ss.str(), box_fg, box_bg);
         }
         screen_buffer.Flush();
+        if (cx::Screen::HasPendingOutput()) cx::Device::RequestFrame(); // 남은 출력은 다음 프레임에
     }
 };
 
@@ -0,0 +1,121 @@
+#include "ConsoleX.hpp"
+
+#include <iostream>
+#include <string>
+
+// =============================================================================
+// [TermApp] pty 기반 터미널 패널 데모
+//   - 박스 안에서 셸을 실행하고, 마우스 휠 / F9, F10으로 스크롤백을 탐색합니다.
+//   - F12: 종료 (그 외 모든 키는 셸로 전달)
+// =============================================================================
+
+int main()
+{
+    cx::Capabilities::Probe();
+
+    cx::Device::EnableMouse( true );
+    cx::Device::EnablePaste( true );
+    cx::Device::EnableKittyKeyboard( true ); // 지원 터미널에서는 ESC가 셸(vim 등)로 지연 없이 전달됨
+
+    cx::Screen::SetBackColor( cx::Color::Black );
+    cx::Screen::Clear();
+    std::cout << std::flush;
+
+    auto size = cx::Screen::GetSize();
+
+    // 상단 바(1줄) + 하단 바(1줄) + 박스 테두리(2줄, 2칸)
+    auto PaneCols = []( const cx::TermSize& s ) { return std::max( s.cols - 2, 1 ); };
+    auto PaneRows = []( const cx::TermSize& s ) { return std::max( s.rows - 4, 1 ); };
+
+    cx::Buffer   buffer;
+    cx::TermPane pane( PaneCols( size ), PaneRows( size ), 5000 );
+
+    if( !pane.Spawn() ) {
+        cx::Device::EnableMouse( false );
+        std::cerr << "Failed to spawn shell." << std::endl;
+        return 1;
+    }
+
+    // 셸 출력이 쏟아져도 최대 60 FPS로만 그리고, 변화가 없으면 잠들어 있음
+    cx::Device::SetFrameRate( 60 );
+    cx::Device::RequestFrame();
+
+    bool is_running = true;
+
+    while( is_running )
+    {
+        const auto event = cx::Device::GetInput();
+
+        // --- [렌더링] --- (RequestFrame() 이후 다음 프레임 시점)
+        if( event.IsFrame() )
+        {
+            buffer.Resize( size.cols, size.rows );
+            buffer.Clear( cx::Color::Black );
+
+            std::string title = pane.GetTitle().empty() ? "shell" : pane.GetTitle();
+            std::string top   = " TermApp | " + title + " ";
+            buffer.DrawString( 0, 0, top, cx::Color::Black, cx::Color::Cyan );
+
+            buffer.DrawBox( 0, 1, pane.GetCols() + 2, pane.GetRows() + 2, cx::Color::Gray, cx::Color::Black );
+            pane.Render( buffer, 1, 2 );
+
+            std::string bottom = " [F9/F10/Wheel] Scroll  [F12] Quit ";
+            if( pane.GetScrollOffset() > 0 ) {
+                bottom += "| Scrollback -" + std::to_string( pane.GetScrollOffset() ) +
+                          "/" + std::to_string( pane.GetScrollbackSize() ) + " ";
+            }
+            buffer.DrawString( 0, size.rows - 1, bottom, cx::Color::Black, cx::Color::Cyan );
+
+            buffer.Flush();
+            if( cx::Screen::HasPendingOutput() ) cx::Device::RequestFrame(); // 남은 출력은 다음 프레임에
+            continue;
+        }
+
+        // --- [입력 처리] ---
+        if( event.IsFd() ) {
+            pane.Pump();
+        }
+        else if( event.IsResize() ) {
+            size = event.term_size;
+            pane.Resize( PaneCols( size ), PaneRows( size ) );
+        }
+        else if( event.IsPaste() ) {
+            pane.SendPaste( event.GetPasteText() );
+        }
+        else if( event.IsMouse() ) {
+            if( event.mouse.action == cx::MouseAction::WHEEL_UP   ) pane.ScrollView( +3 );
+            if( event.mouse.action == cx::MouseAction::WHEEL_DOWN ) pane.ScrollView( -3 );
+        }
+        else if( event.code == cx::DeviceInputCode::F12 ) {
+            is_running = false;
+        }
+        else if( event.code == cx::DeviceInputCode::F9 ) {
+            pane.ScrollView( +pane.GetRows() / 2 );
+        }
+        else if( event.code == cx::DeviceInputCode::F10 ) {
+            pane.ScrollView( -pane.GetRows() / 2 );
+        }
+        else if( !event.IsTimeout() && event.code != cx::DeviceInputCode::INTERRUPT ) {
+            pane.SendKey( event );
+        }
+
+        if( !pane.IsRunning() && pane.GetFd() < 0 ) is_running = false;
+
+        // 셸 출력, 스크롤, 크기 변경 등 모든 변화는 다음 프레임에 한 번에 반영
+        if( pane.IsDirty() ) cx::Device::RequestFrame();
+    }
+
+    pane.Terminate();
+
+    cx::Device::EnableKittyKeyboard( false );
+    cx::Device::EnablePaste( false );
+    cx::Device::EnableMouse( false );
+    cx::Screen::ResetColor();
+    cx::Screen::Clear();
+
+    // 남은 화면 출력을 먼저 모두 씀 (이후 std::cout 출력과 섞이지 않도록)
+    cx::Screen::DrainOutput( std::chrono::seconds( 1 ) );
+    std::cout << "TermApp Terminated." << std::endl;
+
+    return 0;
+}
@@ -8,4 +8,8 @@
 #include "cx_screen.hpp"
 #include "cx_device.hpp"
 #include "cx_util.hpp"
-#include "cx_buffer.hpp"
\ No newline at end of file
+#include "cx_buffer.hpp"
+#include "cx_pane.hpp"
+#include "cx_caps.hpp"
+#include "cx_task.hpp"
+#include "cx_renderer.hpp"
\ No newline at end of file
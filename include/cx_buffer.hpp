@@ -1,23 +1,97 @@
 #pragma once
 
 #include "cx_color.hpp"
+#include "cx_util.hpp"
+#include <cstring>
+#include <unordered_map>
 #include <vector>
 #include <string>
+#include <string_view>
 
 namespace cx {
 
-    // 화면의 한 칸을 나타내는 구조체
+    // 글자 속성 (SGR 비트마스크)
+    enum CellAttr : uint8_t {
+        ATTR_NONE      = 0,
+        ATTR_BOLD      = 1 << 0, // SGR 1
+        ATTR_DIM       = 1 << 1, // SGR 2
+        ATTR_ITALIC    = 1 << 2, // SGR 3
+        ATTR_UNDERLINE = 1 << 3, // SGR 4
+        ATTR_BLINK     = 1 << 4, // SGR 5
+        ATTR_REVERSE   = 1 << 5, // SGR 7
+        ATTR_HIDDEN    = 1 << 6, // SGR 8
+        ATTR_STRIKE    = 1 << 7  // SGR 9
+    };
+
+    // 한 칸에 출력할 문자 (UTF-8, 결합 문자 포함 최대 CAPACITY 바이트를 셀 안에 직접 보관)
+    // - 힙 할당이 없는 고정 크기이므로 Cell 전체를 메모리 비교(SIMD)로 변경 감지할 수 있음
+    // - 사용하지 않는 바이트는 항상 0 (바이트 비교가 내용 비교와 일치하도록)
+    // - 용량을 넘는 결합 문자는 버림
+    class Glyph {
+    public:
+        static constexpr size_t CAPACITY = 19;
+
+        Glyph() { assign(" ", 1); }
+        Glyph(const char* s) { assign(s, std::strlen(s)); }
+        Glyph(std::string_view s) { assign(s.data(), s.size()); }
+
+        Glyph& operator=(const char* s) { assign(s, std::strlen(s)); return *this; }
+        Glyph& operator=(std::string_view s) { assign(s.data(), s.size()); return *this; }
+
+        void assign(const char* s, size_t n) {
+            if (n > CAPACITY) n = CAPACITY;
+            std::memcpy(bytes_, s, n);
+            std::memset(bytes_ + n, 0, CAPACITY - n);
+            len_ = static_cast<uint8_t>(n);
+        }
+
+        void append(const char* s, size_t n) {
+            if (n > CAPACITY - len_) return; // 문자 일부만 붙이지 않음
+            std::memcpy(bytes_ + len_, s, n);
+            len_ = static_cast<uint8_t>(len_ + n);
+        }
+
+        void clear() {
+            std::memset(bytes_, 0, CAPACITY);
+            len_ = 0;
+        }
+
+        bool empty() const { return len_ == 0; }
+        size_t size() const { return len_; }
+        const char* data() const { return bytes_; }
+        operator std::string_view() const { return std::string_view(bytes_, len_); }
+
+        bool operator==(const Glyph& other) const { return len_ == other.len_ && std::memcmp(bytes_, other.bytes_, len_) == 0; }
+        bool operator!=(const Glyph& other) const { return !(*this == other); }
+
+    private:
+        char bytes_[CAPACITY];
+        uint8_t len_;
+    };
+
+    // 화면의 한 칸을 나타내는 구조체 (고정 32바이트, 복사/비교에 할당 없음)
     struct Cell {
-        std::string ch = " ";       // 출력할 문자 (UTF-8)
+        Glyph ch;                   // 출력할 문자 (UTF-8)
         Color fg = Color::White;    // 글자색
         Color bg = Color::Black;    // 배경색
+        uint8_t attr = ATTR_NONE;   // 글자 속성 (CellAttr 비트마스크)
         bool is_wide_trail = false; // 2칸짜리 문자의 뒷부분인지 여부
+        uint8_t width = 1;          // 출력 시 차지하는 칸 수 (그릴 때 계산해 둠, Trail은 0)
+        uint8_t reserved = 0;       // 32바이트를 채우는 예비 칸 (항상 0)
 
         // 변경 감지용 비교 연산자
         bool operator!=(const Cell& other) const {
-            return ch != other.ch || fg != other.fg || bg != other.bg;
+            return ch != other.ch || fg != other.fg || bg != other.bg || attr != other.attr;
         }
     };
+    static_assert(sizeof(Cell) == 32, "Cell must stay 32 bytes (one AVX2 compare per cell in Flush)");
+
+    // 글자 스타일 (SGR 해석 결과)
+    struct TextStyle {
+        Color fg = Color::White;
+        Color bg = Color::Black;
+        uint8_t attr = ATTR_NONE;
+    };
 
     // 더블 버퍼링 렌더러 클래스
     class Buffer {
@@ -34,13 +108,66 @@ namespace cx {
         // 문자열 그리기 (좌표 x, y)
         void DrawString(int x, int y, const std::string& text, const Color& fg, const Color& bg);
 
+        // ANSI 색상 코드가 포함된 문자열 그리기 (좌표 x, y)
+        // - SGR(색상/속성)을 해석하여 Cell에 반영하고, 그 외 시퀀스는 무시합니다.
+        // - '\n'은 다음 줄의 x 위치로, '\r'은 현재 줄의 x 위치로 이동합니다.
+        // - fg, bg는 SGR 0/39/49(기본값 복원) 시 사용할 색상입니다.
+        void DrawAnsi(int x, int y, std::string_view text,
+                      const Color& fg = Color::White, const Color& bg = Color::Black);
+
+        // 셀 하나를 그대로 기록 (외부 셀 그리드 합성용, 범위 밖은 무시)
+        void SetCell(int x, int y, const Cell& cell);
+
         // 박스 그리기 (UI 테두리용)
         void DrawBox(int x, int y, int w, int h, const Color& fg, const Color& bg, bool red_border = false);
 
         // [핵심] 변경된 부분만 터미널로 출력 (Render)
+        // - 출력은 Screen::Write()의 터미널 출력 큐를 거침 (Non-Blocking, 다 받지 못한 나머지는 다음 Flush()에서 이어서 씀)
+        // - 남은 출력이 예산(SetOutputBudget)보다 많으면 이번 프레임은 건너뛰고, 다음 Flush()가 합쳐서 출력
+        //   (느린 SSH에서도 앱이 출력에 막히지 않고, 화면은 항상 최신 상태로 수렴)
+        // - Screen::HasPendingOutput()이 true이면 다음 프레임을 요청하여 Flush()를 다시 호출
+        //   (std::cout으로 직접 출력하기 전, 종료 전에는 Screen::DrainOutput() 먼저)
         void Flush();
 
+        // 터미널 출력 큐에 남은 출력이 bytes 이하일 때만 새 프레임을 만듦 (기본 0: 이전 출력을 모두 쓴 뒤에만)
+        void SetOutputBudget(size_t bytes) { output_budget_ = bytes; }
+
+        // 출력이 밀려서 다음 프레임으로 합쳐진 Flush() 횟수
+        size_t GetMergedFrames() const { return merged_frames_; }
+
+        // 큰 화면에서 Flush()의 Diff를 행 구간으로 나누어 여러 스레드로 계산 (threads <= 1: 사용 안 함)
+        // - 셀 수(가로 x 세로)가 min_cells 이상일 때만 나눔 (작은 화면은 스레드 전환 비용이 더 큼)
+        // - 구간마다 절대 좌표 이동과 전체 SGR로 시작하므로, 결과는 순서대로 이어 붙여 한 번에 출력
+        static constexpr int DEFAULT_PARALLEL_MIN_CELLS = 40000; // 예: 200 x 200
+        void SetParallelFlush(int threads, int min_cells = DEFAULT_PARALLEL_MIN_CELLS) {
+            parallel_threads_ = threads;
+            parallel_min_cells_ = min_cells;
+        }
+
+        // 행 단위로 위/아래로 옮겨진 내용(로그, 목록 스크롤 등)을 찾아 터미널 스크롤(DECSTBM + SU/SD)로 옮김
+        // - 행 해시로 옮겨진 행을 찾고, 다시 그리지 않아도 되는 행이 충분할 때만 스크롤
+        // - 터미널 스크롤은 줄 전체를 옮기므로, 버퍼 가로 폭이 터미널과 같을 때만 사용 (Flush()마다 확인)
+        void SetScrollDetection(bool enable) { scroll_detection_ = enable; }
+
+        // 터미널 스크롤로 행을 옮긴 Flush() 횟수
+        size_t GetScrolledFrames() const { return scrolled_frames_; }
+
+        // Flush()의 변경 셀 검색에 SIMD 비교를 사용할지 (기본 true, 모든 Buffer 공통)
+        // - false: 셀마다 operator!=로 비교 (벤치마크 기준, example/main_flush_bench.cpp)
+        static void SetSimdDiff(bool enable);
+
+        // 현재 사용하는 변경 셀 검색 구현 ("avx2", "sse2", "scalar", SIMD를 끄면 "cell")
+        static const char* GetDiffScanName();
+
+        int GetWidth() const { return width_; }
+        int GetHeight() const { return height_; }
+
+        // SGR(CSI ... m) 토큰을 style에 적용 (base: 리셋 시 돌아갈 기본 스타일)
+        static void ApplySgr(const AnsiTokenizer::Token& token, TextStyle& style, const TextStyle& base);
+
     private:
+        friend class Renderer; // 렌더 스레드가 Back 버퍼를 복사 없이 맞바꿈
+
         int width_ = 0;
         int height_ = 0;
 
@@ -48,8 +175,40 @@ namespace cx {
         std::vector<std::vector<Cell>> front_buffer_;
         std::vector<std::vector<Cell>> back_buffer_;
 
-        // 내부 헬퍼: 버퍼 초기화
-        void ClearImpl(std::vector<std::vector<Cell>>& buf, const Color& bg);
+        // 행 해시 (셀을 쓸 때마다 갱신, Flush()는 해시가 같은 행을 건너뜀)
+        // - Back: 그리는 동안 셀 단위로 갱신, Front: Diff로 동기화한 행의 해시
+        // - 행 위치(y)는 섞지 않으므로 다른 위치로 옮겨진 행도 같은 해시
+        std::vector<uint64_t> front_hash_;
+        std::vector<uint64_t> back_hash_;
+
+        // 스크롤 감지 (Front 행 해시 -> 위치, 프레임마다 재사용)
+        bool scroll_detection_ = false;
+        size_t scrolled_frames_ = 0;
+        std::unordered_map<uint64_t, int> row_index_;
+
+        // 출력이 밀렸을 때 프레임 병합 (SetOutputBudget)
+        size_t output_budget_ = 0;
+        size_t merged_frames_ = 0;
+
+        // 병렬 Diff 설정과 구간별 출력 (프레임마다 재사용하여 할당을 줄임)
+        int parallel_threads_ = 1;
+        int parallel_min_cells_ = DEFAULT_PARALLEL_MIN_CELLS;
+        std::vector<std::string> band_out_;
+
+        // 내부 헬퍼: Flush() 출력 옵션 복사 (Renderer가 제출된 버퍼의 옵션을 Writer 버퍼에 적용)
+        void CopyFlushOptions(const Buffer& other);
+
+        // 내부 헬퍼: [y_begin, y_end) 행의 변경 부분을 out_buf에 출력하고 Front 동기화
+        void DiffRows(int y_begin, int y_end, ColorDepth depth, std::string& out_buf);
+
+        // 내부 헬퍼: 옮겨진 행을 찾아 스크롤 시퀀스를 out_buf에 출력하고 Front 행을 같이 옮김
+        void ScrollMovedRows(std::string& out_buf);
+
+        // 내부 헬퍼: 버퍼 초기화 (행 해시도 함께 갱신)
+        void ClearImpl(std::vector<std::vector<Cell>>& buf, std::vector<uint64_t>& hashes, const Color& bg);
+
+        // 내부 헬퍼: 텍스트 런(제어 문자 없음)을 cursor_x부터 그리고 cursor_x를 전진
+        void DrawRun(int& cursor_x, int y, std::string_view run, const TextStyle& style);
     };
 
 } // namespace cx
\ No newline at end of file
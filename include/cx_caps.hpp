@@ -0,0 +1,71 @@
+#ifndef _CONSOLE_X_CAPS_HPP_
+#define _CONSOLE_X_CAPS_HPP_
+
+/** ------------------------------------------------------------------------------------
+ *  ConsoleX Terminal Capabilities
+ *  ------------------------------------------------------------------------------------
+ *  터미널이 지원하는 기능(색상 수, 마우스, 붙여넣기, 동기화 출력 등)을 감지하여 보관합니다.
+ *  cx::Buffer::Flush()와 cx::Device가 이 정보를 보고 출력/요청할 시퀀스를 고릅니다.
+ *
+ *  - 환경 변수(TERM, COLORTERM)와 terminfo로 먼저 추정하고,
+ *  - Probe()를 호출하면 터미널에 직접 질의(DA1/DA2, XTVERSION, XTGETTCAP, DECRQM)하여 확정합니다.
+ *  - 확정한 결과는 $TERM별로 캐시 파일에 저장되어, 다음 실행부터는 질의 왕복 없이 사용됩니다.
+ *  ------------------------------------------------------------------------------------ */
+
+#include "cx_color.hpp" // ColorDepth
+
+#include <chrono>      // std::chrono::milliseconds
+#include <memory>      // std::shared_ptr
+#include <string>      // std::string
+
+namespace cx
+{
+    /**
+     * @brief 터미널 기능 프로필
+     *
+     * @details
+     *   Current()는 읽기 전용 스냅샷을 반환하므로, 렌더 스레드와 입력 스레드가 동시에 읽어도 안전합니다.
+     *   (Probe()나 Set()이 새 프로필로 교체해도, 이미 받은 스냅샷은 그대로 유효함)
+     *
+     * @code
+     *   cx::Capabilities::Probe();   // 앱 시작 시 한 번 (캐시가 있으면 즉시 반환)
+     *   if( cx::Capabilities::Current()->sync_output ) { ... }
+     * @endcode
+     */
+    struct Capabilities
+    {
+        std::string term;                                   // $TERM
+        std::string term_program;                           // $TERM_PROGRAM $TERM_PROGRAM_VERSION (같은 $TERM을 쓰는 에뮬레이터 구분)
+        std::string version;                                // 터미널 이름과 버전 (XTVERSION, 없으면 DA2 응답)
+        ColorDepth  color_depth     = ColorDepth::TRUECOLOR;
+        bool        sgr_mouse       = true;                 // SGR 마우스 보고 (?1006)
+        bool        bracketed_paste = true;                 // Bracketed Paste (?2004)
+        bool        sync_output     = false;                // 동기화 출력 (?2026, 프레임 단위로 화면 갱신하여 찢어짐 방지)
+        bool        kitty_keyboard  = false;                // kitty 키보드 프로토콜 (CSI ? u)
+        bool        probed          = false;                // 터미널 응답으로 확인한 값인지 (false: 환경 변수/terminfo 추정)
+
+        /// @brief 현재 프로필 (처음 호출 시 캐시 파일 또는 환경 변수/terminfo로 추정, 터미널 질의 없음)
+        static std::shared_ptr<const Capabilities> Current( void );
+
+        /**
+         * @brief   터미널에 질의하여 프로필을 확정하고 캐시 파일에 저장합니다.
+         * @param   timeout   질의 응답 제한 시간 (지원하는 터미널은 보통 수 ms 안에 모두 응답)
+         * @param   use_cache false면 캐시를 무시하고 다시 질의 (터미널을 업데이트한 경우 등)
+         * @details 모든 질의 뒤에 DA1을 보내고, DA1 응답이 오면 바로 끝냅니다.
+         *          (터미널은 순서대로 응답하므로, 그때까지 오지 않은 질의는 지원하지 않는 것)
+         *          표준 입출력이 터미널이 아니면 질의하지 않고 추정값을 사용합니다.
+         */
+        static std::shared_ptr<const Capabilities> Probe( std::chrono::milliseconds timeout = std::chrono::milliseconds( 300 ),
+                                                          bool use_cache = true );
+
+        /// @brief 프로필을 직접 지정합니다. (사용자 설정, 테스트 등)
+        static void Set( const Capabilities& caps );
+
+        /// @brief $TERM과 터미널 프로그램별 캐시 파일 경로 ($XDG_CACHE_HOME 또는 ~/.cache 아래 consolex/)
+        /// @note  term_program의 버전(공백 뒤)은 파일 이름에 쓰지 않고, 파일 안의 값과 비교하여 바뀌면 다시 질의합니다.
+        static std::string GetCachePath( const std::string& term, const std::string& term_program = "" );
+    };
+
+} // namespace cx
+
+#endif // _CONSOLE_X_CAPS_HPP_
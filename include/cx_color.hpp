@@ -24,12 +24,22 @@ namespace cx
         bool operator!=( const Rgb& other ) const { return !(*this == other); }
     };
 
+    // 터미널이 표현할 수 있는 색상 수 (cx::Capabilities로 감지, 출력 시 가까운 색으로 변환)
+    enum class ColorDepth : uint8_t
+    {
+        MONO,      // 색상 없음 (dumb 터미널)
+        ANSI16,    // 기본 16색 (SGR 30~37, 90~97)
+        ANSI256,   // xterm 256색 (SGR 38;5;n)
+        TRUECOLOR  // 24-bit RGB (SGR 38;2;r;g;b)
+    };
+
     // 색상 관리 클래스
     class Color
     {
     public:
         // 색상 타입 (일반 RGB, 터미널 기본값 복구, 없음)
-        enum class Type { RGB, RESET, NONE };
+        // (uint8_t: Color를 4바이트로 유지하여 cx::Cell을 고정 크기로 만듦)
+        enum class Type : uint8_t { RGB, RESET, NONE };
 
     public:
         // 기본 생성자 (Type::NONE - 투명/무시)
@@ -45,12 +55,23 @@ namespace cx
         // 특수 타입 생성 (주로 Color::Reset() 내부 사용)
         Color( Type type );
 
+        // xterm 256색 팔레트 인덱스로 생성 (0~15: 기본색, 16~231: 6x6x6 큐브, 232~255: 회색조)
+        static Color FromAnsi256( uint8_t index );
+
         // 전경색(글자색)용 ANSI 시퀀스 반환 (예: "\033[38;2;R;G;Bm")
         std::string ToAnsiForeground() const;
 
         // 배경색용 ANSI 시퀀스 반환 (예: "\033[48;2;R;G;Bm")
         std::string ToAnsiBackground() const;
 
+        // 색상 수에 맞춘 ANSI 시퀀스 반환 (256색/16색 터미널은 가장 가까운 팔레트 색, MONO는 빈 문자열)
+        std::string ToAnsiForeground( ColorDepth depth ) const;
+        std::string ToAnsiBackground( ColorDepth depth ) const;
+
+        // 가장 가까운 xterm 256색 / 기본 16색 팔레트 인덱스
+        uint8_t ToAnsi256() const;
+        uint8_t ToAnsi16() const;
+
         // Hex 문자열 반환 (예: "#RRGGBB")
         std::string ToHex() const;
 
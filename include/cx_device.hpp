@@ -5,24 +5,30 @@
  *  ConsoleX Device Input Module
  *  ------------------------------------------------------------------------------------
  *  키보드/마우스 입력 처리, 시그널 핸들링, 스레드 안전한 입력 대기열 관리를 담당합니다.
+ *  입력은 전용 Reader 스레드가 읽고 파싱하여, 구독자(Subscription)별 Lock-Free 큐로 배포합니다.
  *  화면 출력(Output)과 관련된 기능은 cx::Screen 모듈로 분리되었습니다.
  *  ------------------------------------------------------------------------------------ */
 
 // Coord, TermSize 정의 사용
 #include "cx_screen.hpp"
+#include "cx_queue.hpp"
 
 // System & STL Includes
-#include <termios.h> // termios struct
-#include <unistd.h>  // read, write
-#include <signal.h>  // sigaction
-#include <memory>    // std::unique_ptr
-#include <mutex>     // std::mutex
-#include <chrono>    // std::chrono
-#include <optional>  // std::optional
-#include <string>    // std::string
-#include <atomic>    // std::atomic
-#include <vector>    // std::vector
-#include <future>    // std::promise, std::future
+#include <termios.h>   // termios struct
+#include <unistd.h>    // read, write
+#include <signal.h>    // sigaction
+#include <memory>      // std::unique_ptr
+#include <mutex>       // std::mutex
+#include <chrono>      // std::chrono
+#include <optional>    // std::optional
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <atomic>      // std::atomic
+#include <vector>      // std::vector
+#include <deque>       // std::deque
+#include <functional>  // std::function
+#include <thread>      // std::thread
+#include <span>        // std::span
 
 namespace cx
 {
@@ -38,12 +44,16 @@ namespace cx
         // --- Meta Signals ---
         NONE         = -1,   // 입력 없음 / 타임아웃
         INTERRUPT    = -2,   // ForcePause / Signal에 의한 중단
-        BUSY         = -3,   // 다른 스레드가 이미 입력을 점유 중임
+        BUSY         = -3,   // (사용 안 함) 구 버전의 입력 점유 충돌 코드. 호환성을 위해 유지
 
         // --- Events ---
         MOUSE_EVENT  = 2000, // 마우스 동작
         RESIZE_EVENT = 3000, // 터미널 크기 변경 (SIGWINCH)
         CURSOR_EVENT = 4000, // 커서 위치 응답 (내부 처리용)
+        FD_EVENT     = 5000, // WatchFd()로 등록한 파일 디스크립터 준비됨 (읽기/쓰기 가능, 끊김)
+        FRAME_EVENT  = 6000, // 프레임 스케줄러의 렌더링 시점 (RequestFrame / SetFrameRate)
+        PASTE_EVENT  = 7000, // 붙여넣기 한 번 (EnablePaste, 내용은 Event::paste)
+        TEXT_EVENT   = 8000, // ASCII 외 문자 입력 (한글, 이모지 등, 문자는 Event::codepoint)
 
         // --- Standard Keys ---
         TAB = 9, ENTER = 10, ESC = 27, SPACE = 32, BACKSPACE = 127,
@@ -73,6 +83,122 @@ namespace cx
         MouseAction action = MouseAction::UNKNOWN;
     };
 
+    /// @brief 키 이벤트 종류 (REPEAT/RELEASE는 kitty 키보드 프로토콜의 KITTY_REPORT_EVENTS 사용 시에만 발생)
+    enum class KeyAction { PRESS, REPEAT, RELEASE };
+
+    /**
+     * @brief 키와 함께 눌린 수식 키 (비트마스크)
+     * @note  xterm 수식 파라미터(ESC[1;5A의 5)에서 1을 뺀 값과 같은 배치입니다.
+     *        문자 키는 Shift가 이미 반영된 글자('A')로 전달되므로 MOD_SHIFT가 붙지 않습니다.
+     */
+    enum KeyMod : uint8_t
+    {
+        MOD_NONE  = 0,
+        MOD_SHIFT = 1 << 0,
+        MOD_ALT   = 1 << 1,
+        MOD_CTRL  = 1 << 2,
+        MOD_META  = 1 << 3,
+    };
+
+    /**
+     * @brief kitty 키보드 프로토콜 기능 (비트마스크, 터미널에 CSI > flags u로 요청)
+     *
+     * @details
+     *   - KITTY_DISAMBIGUATE     : ESC, Alt/Ctrl 조합을 모호하지 않은 CSI u 시퀀스로 받음 (ESC 판별 대기 없음)
+     *   - KITTY_REPORT_EVENTS    : 키 반복(REPEAT), 뗌(RELEASE)도 받음 (Event::key_action)
+     *   - KITTY_REPORT_ALTERNATE : Shift가 적용된 글자도 함께 받음 (Shift+1 -> '!')
+     *   - KITTY_REPORT_ALL_KEYS  : Enter, Tab 등 모든 키를 CSI u로 받음 (수식 키 단독 입력은 무시됨)
+     */
+    enum KittyFlag : uint8_t
+    {
+        KITTY_DISAMBIGUATE     = 1 << 0,
+        KITTY_REPORT_EVENTS    = 1 << 1,
+        KITTY_REPORT_ALTERNATE = 1 << 2,
+        KITTY_REPORT_ALL_KEYS  = 1 << 3,
+    };
+
+    /**
+     * @brief 사용자 fd 감시 조건 및 FD_EVENT 발생 원인 (비트마스크)
+     */
+    enum FdFlag : uint8_t
+    {
+        FD_READ   = 1 << 0, // 읽기 가능
+        FD_WRITE  = 1 << 1, // 쓰기 가능
+        FD_HANGUP = 1 << 2, // 상대편이 닫힘 (결과 전용)
+        FD_ERROR  = 1 << 3, // 에러 (결과 전용)
+    };
+
+    /**
+     * @brief 구독자별 이벤트 병합 정책 (비트마스크)
+     *
+     * @details
+     *   병합 대상 이벤트가 큐에 연속으로 쌓여 있으면, 꺼낼 때 마지막 것 하나만 전달합니다.
+     *   (다른 종류의 이벤트를 건너뛰어 병합하지 않으므로 이벤트 순서는 유지됩니다)
+     *   - 창 이동처럼 최신 위치만 필요한 UI     : COALESCE_DRAG
+     *   - 선 그리기처럼 중간 좌표가 모두 필요한 UI : COALESCE_NONE (기본값)
+     */
+    enum CoalesceFlag : uint8_t
+    {
+        COALESCE_NONE   = 0,
+        COALESCE_DRAG   = 1 << 0, // 같은 버튼의 연속된 MouseAction::DRAG
+        COALESCE_RESIZE = 1 << 1, // 연속된 RESIZE_EVENT
+    };
+
+    /**
+     * @brief 프레임 스케줄러 동작 방식
+     *
+     * @details
+     *   - ON_DEMAND  : RequestFrame()으로 요청했을 때만 FRAME_EVENT 발생 (요청이 없으면 무한 대기)
+     *   - CONTINUOUS : 애니메이션처럼 매 프레임 갱신이 필요할 때, 고정 FPS로 계속 발생
+     */
+    enum class FramePacing { ON_DEMAND, CONTINUOUS };
+
+    // =========================================================================
+    // Terminal Queries
+    // =========================================================================
+
+    /**
+     * @brief 터미널에 보낼 수 있는 질의 종류 (Device::Query)
+     */
+    enum class TermQuery
+    {
+        CURSOR_POS,       // DSR 6       : ESC[6n      -> ESC[row;colR
+        PRIMARY_DA,       // DA1         : ESC[c       -> ESC[?62;22;...c  (지원 기능 목록)
+        SECONDARY_DA,     // DA2         : ESC[>c      -> ESC[>type;version;0c
+        MODE,             // DECRQM      : ESC[?mode$p -> ESC[?mode;status$y (arg: DEC 모드 번호, 예: 2026)
+        VERSION,          // XTVERSION   : ESC[>0q     -> DCS >|name(version) ST
+        FOREGROUND_COLOR, // OSC 10      : 기본 글자색
+        BACKGROUND_COLOR, // OSC 11      : 기본 배경색
+        PALETTE_COLOR,    // OSC 4       : 팔레트 색 (arg: 0 ~ 255)
+        KEYBOARD_FLAGS,   // kitty       : ESC[?u      -> ESC[?flags u (응답이 오면 kitty 키보드 프로토콜 지원)
+        TERMCAP,          // XTGETTCAP   : DCS +q name ST -> DCS 1+r name=value ST (name: terminfo 이름, 예: "RGB")
+    };
+
+    /**
+     * @brief 터미널 질의 결과
+     * @details ok가 false이면 제한 시간 안에 응답이 없었던 것입니다. (해당 질의를 지원하지 않는 터미널)
+     */
+    struct QueryReply
+    {
+        TermQuery        query  = TermQuery::CURSOR_POS;
+        int              arg    = 0;      // 질의 시 넘긴 인자 (MODE, PALETTE_COLOR)
+        std::string      name;            // 질의 시 넘긴 이름 (TERMCAP)
+        bool             ok     = false;  // 응답 수신 여부
+        Coord            cursor = {};     // CURSOR_POS (0-based)
+        std::vector<int> params;          // PRIMARY_DA, SECONDARY_DA : 응답 파라미터 / MODE : { 모드, 상태 }
+                                          // KEYBOARD_FLAGS : { 현재 기능 } / TERMCAP : { 1: 있음, 0: 없음 }
+        std::string      text;            // VERSION : 이름과 버전 / *_COLOR : 색상 원문 (예: "rgb:ffff/ffff/ffff") / TERMCAP : 값
+        Rgb              rgb    = {};     // *_COLOR : 원문을 8비트 RGB로 변환한 값
+
+        /// @brief DECRQM 상태 (0: 모름, 1: 켜짐, 2: 꺼짐, 3: 항상 켜짐, 4: 항상 꺼짐)
+        int GetModeStatus( void ) const { return params.size() >= 2 ? params[1] : 0; }
+
+        /// @brief DECRQM 결과로 본 모드 지원 여부
+        bool IsModeSupported( void ) const { return ok && GetModeStatus() != 0; }
+    };
+
+    using QueryCallback = std::function<void( const QueryReply& )>;
+
     // =========================================================================
     // Device Class (Singleton)
     // =========================================================================
@@ -95,50 +221,244 @@ namespace cx
          *
          * @details
          *   데이터 흐름: Device Input Pipeline -> Parse -> Event Struct
+         *   이벤트는 파싱 시점의 데이터를 모두 담은 값(Value)이므로,
+         *   여러 개를 모아 두었다가 나중에 처리해도 좌표 등이 덮어써지지 않습니다.
          */
         struct Event
         {
             // 이벤트의 종류 (가장 먼저 확인해야 함!)
             DeviceInputCode code = DeviceInputCode::NONE;
 
+            // 유효 조건: 키 입력, MOUSE_EVENT (KeyMod 조합, 예: Ctrl+C -> code == c, mods == MOD_CTRL)
+            uint8_t    mods      = MOD_NONE;
+
+            // 유효 조건: TEXT_EVENT 또는 출력 가능한 ASCII 키 (입력된 문자의 유니코드 코드포인트)
+            uint32_t   codepoint = 0;
+
+            // 유효 조건: 키 입력 (누름/반복/뗌, kitty 키보드 프로토콜이 아니면 항상 PRESS)
+            KeyAction  key_action = KeyAction::PRESS;
+
             // --- Context-Dependent Data (Mutually Exclusive) ---
             MouseState mouse     = {}; // 유효 조건: code == MOUSE_EVENT (그 외엔 쓰레기값 혹은 0)
             TermSize   term_size = {}; // 유효 조건: code == RESIZE_EVENT
             Coord      cursor    = {}; // 유효 조건: code == CURSOR_EVENT (동기 요청의 응답)
+            int        fd        = -1; // 유효 조건: code == FD_EVENT (준비된 디스크립터)
+            uint8_t    fd_ready  = 0;  // 유효 조건: code == FD_EVENT (FdFlag 조합: 읽기/쓰기 가능, 끊김 등)
+            uint64_t   frame     = 0;  // 유효 조건: code == FRAME_EVENT (1부터 증가하는 프레임 번호)
+            uint32_t   frame_skipped = 0; // 유효 조건: code == FRAME_EVENT (직전 프레임 이후 놓친 틱 수, CONTINUOUS 전용)
+
+            // 유효 조건: code == PASTE_EVENT (붙여넣은 바이트 전체, 구독자끼리 복사 없이 공유)
+            std::shared_ptr<const std::string> paste {};
+
+            // 입력을 읽은 시각 (모든 이벤트에 유효, 드래그 보간이나 지연 측정에 사용)
+            std::chrono::steady_clock::time_point timestamp = {};
 
             // --- Helper Predicates (Safe Check) ---
             bool IsTimeout( void ) const { return code == DeviceInputCode::NONE;         } // 타임아웃이나 잘못된 입력인지 확인
             bool IsMouse  ( void ) const { return code == DeviceInputCode::MOUSE_EVENT;  } // 마우스 이벤트인지 확인   ( mouse 필드 접근 가능 )
             bool IsResize ( void ) const { return code == DeviceInputCode::RESIZE_EVENT; } // 리사이즈 이벤트인지 확인 ( term_size 필드 접근 가능 )
             bool IsCursor ( void ) const { return code == DeviceInputCode::CURSOR_EVENT; } // 커서 위치 응답인지 확인  ( cursor 필드 접근 가능 )
+            bool IsFd     ( void ) const { return code == DeviceInputCode::FD_EVENT;     } // 등록한 fd 이벤트인지 확인 ( fd 필드 접근 가능 )
+            bool IsFrame  ( void ) const { return code == DeviceInputCode::FRAME_EVENT;  } // 렌더링 시점인지 확인     ( frame 필드 접근 가능 )
+            bool IsPaste  ( void ) const { return code == DeviceInputCode::PASTE_EVENT;  } // 붙여넣기인지 확인       ( GetPasteText() 사용 가능 )
+            bool IsText   ( void ) const { return code == DeviceInputCode::TEXT_EVENT;   } // 비ASCII 문자 입력인지 확인 ( codepoint 필드 접근 가능 )
+
+            /// @brief 단축키 확인 (수식 키 조합까지 정확히 일치해야 true, 예: IsKey( Key::s, MOD_CTRL ), 뗌 이벤트는 제외)
+            bool IsKey( DeviceInputCode key, uint8_t modifiers = MOD_NONE ) const
+            {
+                return code == key && mods == modifiers && key_action != KeyAction::RELEASE;
+            }
+
+            /// @brief 키를 뗀 이벤트인지 확인 (KITTY_REPORT_EVENTS 사용 시)
+            bool IsRelease( void ) const { return key_action == KeyAction::RELEASE; }
+
+            /// @brief 붙여넣은 내용 (PASTE_EVENT가 아니면 빈 문자열)
+            std::string_view GetPasteText( void ) const { return paste ? std::string_view( *paste ) : std::string_view(); }
+        };
+
+    private:
+        struct Channel; // 구독자별 이벤트 큐 (구현은 cx_device.cpp)
+
+    public:
+        static constexpr size_t DEFAULT_QUEUE_CAPACITY = 1024; // 구독자 큐 기본 용량
+
+        /**
+         * @brief 입력 이벤트 구독 핸들 (Move Only, 소멸 시 자동 구독 해제)
+         *
+         * @details
+         *   Reader 스레드가 파싱한 이벤트는 모든 구독자의 큐에 각각 복사됩니다. (Broadcast)
+         *   렌더 스레드, 워커 스레드, 감시 스레드가 각자 Subscribe() 하면
+         *   서로 입력을 빼앗지 않고 같은 이벤트 흐름을 받을 수 있습니다.
+         *   하나의 Subscription을 여러 스레드가 함께 소비하면 이벤트가 나누어 전달됩니다.
+         *
+         *   큐가 가득 차면 새 이벤트는 버려지고 GetDroppedCount()가 증가합니다.
+         */
+        class Subscription
+        {
+        public:
+            Subscription( void ) = default;
+            ~Subscription();
+
+            Subscription( Subscription&& other ) noexcept;
+            Subscription& operator=( Subscription&& other ) noexcept;
+
+            Subscription( const Subscription& ) = delete;
+            Subscription& operator=( const Subscription& ) = delete;
+
+            /// @brief [Non-Blocking] 대기 중인 이벤트가 있으면 꺼냅니다.
+            std::optional<Event> Poll( void ) { return WaitMs( 0 ); }
+
+            /// @brief [Blocking] 이벤트가 올 때까지 무한 대기합니다.
+            Event Wait( void ) { return WaitMs( -1 ).value_or( Event{} ); }
+
+            /// @brief [Timeout] 지정된 시간 동안 이벤트를 기다립니다. 타임아웃 시 nullopt
+            template <typename Rep, typename Period>
+            std::optional<Event> WaitFor( const std::chrono::duration<Rep, Period>& timeout )
+            {
+                auto ms = std::chrono::duration_cast<std::chrono::milliseconds>( timeout ).count();
+                return WaitMs( (int)ms );
+            }
+
+            /**
+             * @brief  [Batch] 이벤트를 한꺼번에 꺼냅니다.
+             * @details 첫 이벤트가 올 때까지 timeout만큼 기다린 뒤,
+             *          그 시점에 큐에 쌓여 있는 이벤트를 out이 찰 때까지 대기 없이 모두 꺼냅니다.
+             * @return  out에 채운 이벤트 수 (타임아웃이면 0)
+             */
+            template <typename Rep, typename Period>
+            size_t Drain( std::span<Event> out, const std::chrono::duration<Rep, Period>& timeout )
+            {
+                auto ms = std::chrono::duration_cast<std::chrono::milliseconds>( timeout ).count();
+                return DrainMs( out, (int)ms );
+            }
+
+            /**
+             * @brief   [Thread-Safe] 이 구독자의 큐에 이벤트를 직접 넣습니다.
+             * @details Wait() 중인 소비자를 다른 스레드에서 깨울 때 사용합니다. (예: code == NONE인 빈 이벤트)
+             */
+            void Post( const Event& event );
+
+            /// @brief 이 구독자의 이벤트 병합 정책 설정 (CoalesceFlag 조합)
+            void SetCoalesce( uint8_t flags );
+
+            /// @brief 큐가 가득 차서 버려진 이벤트 수
+            size_t GetDroppedCount( void ) const;
+
+            bool IsValid( void ) const { return channel_ != nullptr; }
+
+        private:
+            friend class Device;
+            explicit Subscription( std::shared_ptr<Channel> channel ) : channel_( std::move( channel ) ) {}
+
+            std::optional<Event> WaitMs( int timeout_ms );
+            size_t DrainMs( std::span<Event> out, int timeout_ms );
+            void Release( void );
+
+            std::shared_ptr<Channel> channel_;
         };
 
     // --- Public Static API ---------------------------------------------------
     public:
+        /**
+         * @brief  입력 이벤트를 구독합니다.
+         * @param  capacity       구독자 큐 용량 (2의 거듭제곱으로 올림)
+         * @param  with_loop_events 이벤트 루프용 이벤트(FD_EVENT, FRAME_EVENT)도 받을지 여부
+         *                         (앱의 메인 루프처럼 fd 처리와 렌더링을 담당하는 구독자만 true)
+         * @return 구독 핸들 (핸들이 소멸하면 구독 해제)
+         */
+        static Subscription Subscribe( size_t capacity = DEFAULT_QUEUE_CAPACITY, bool with_loop_events = false );
+
+        /**
+         * @brief GetInput() / GetEvents()가 사용하는 기본 구독의 이벤트 병합 정책 설정
+         * @param flags CoalesceFlag 조합 (예: COALESCE_DRAG | COALESCE_RESIZE)
+         */
+        static void SetCoalesce( uint8_t flags );
+
         /**
          * @brief [Blocking] 입력을 무한 대기합니다.
+         * @note  GetInput() 계열은 프로세스 공용 기본 구독을 사용합니다. (처음 호출할 때 만들어지며, 그 이전 입력은 받지 않음)
+         *        여러 스레드가 동시에 호출하면 이벤트가 먼저 대기한 스레드들에게 나누어 전달됩니다.
          */
-        static DeviceInputCode GetInput( void );
+        static Event GetInput( void );
 
         /**
          * @brief  [Timeout] 지정된 시간 동안 입력을 대기합니다.
-         * @return 값이 있으면 DeviceInputCode, 타임아웃 시 std::nullopt
+         * @return 값이 있으면 이벤트, 타임아웃 시 std::nullopt
          */
         template <typename Rep, typename Period>
-        static std::optional<DeviceInputCode> GetInput( const std::chrono::duration<Rep, Period>& duration )
+        static std::optional<Event> GetInput( const std::chrono::duration<Rep, Period>& duration )
         {
             auto ms = std::chrono::duration_cast<std::chrono::milliseconds>( duration ).count();
             return GetPtr()->GetInputMs( (int)ms );
         }
 
         /**
-         * @brief GetInput 결과 코드를 상세 이벤트 객체(Event)로 변환합니다.
+         * @brief  [Batch] 현재까지 들어온 입력을 한 번에 모두 꺼냅니다.
+         * @details 마우스 드래그처럼 이벤트가 몰려 들어올 때, 묶음 전체를 처리하고 한 번만 렌더링하는 용도입니다.
+         *          첫 이벤트가 올 때까지 timeout만큼 기다리고, 이후에는 대기 없이 쌓여 있는 것만 꺼냅니다.
+         * @return  out에 채운 이벤트 수 (타임아웃이면 0)
+         *
+         * @code
+         *   std::array<cx::Device::Event, 64> events;
+         *   size_t n = cx::Device::GetEvents( events, 16ms );
+         *   for( size_t i = 0; i < n; ++i ) ProcessInput( events[i] );
+         *   Render();
+         * @endcode
+         */
+        template <typename Rep, typename Period>
+        static size_t GetEvents( std::span<Event> out, const std::chrono::duration<Rep, Period>& timeout )
+        {
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>( timeout ).count();
+            return GetPtr()->GetEventsMs( out, (int)ms );
+        }
+
+        /// @brief [Batch, Blocking] 첫 이벤트가 올 때까지 무한 대기한 뒤, 쌓인 이벤트를 모두 꺼냅니다.
+        static size_t GetEvents( std::span<Event> out ) { return GetPtr()->GetEventsMs( out, -1 ); }
+
+        /**
+         * @brief GetInput 결과를 이벤트 객체(Event)로 풀어 줍니다. (타임아웃이면 code == NONE)
+         */
+        static Event Inspect( const std::optional<Event>& opt_event );
+
+        /**
+         * @brief 키 코드만으로 이벤트 객체를 만듭니다. (상세 데이터는 RESIZE_EVENT의 현재 크기만 채움)
          */
         static Event Inspect( const std::optional<DeviceInputCode>& opt_key );
 
+        static constexpr std::chrono::milliseconds DEFAULT_QUERY_TIMEOUT { 500 };
+
+        /**
+         * @brief   [Async] 터미널에 질의를 보내고, 응답이 오면 callback을 호출합니다.
+         * @param   arg     질의 인자 (MODE: 모드 번호, PALETTE_COLOR: 팔레트 번호, 그 외: 무시)
+         * @param   timeout 응답 제한 시간 (넘으면 ok == false로 callback 호출)
+         * @details 응답은 Reader 스레드의 파서가 질의 종류별 순서대로 짝지으며,
+         *          그 사이에 들어온 키/마우스 입력은 구독자에게 그대로 전달됩니다.
+         *          callback은 응답이든 타임아웃이든 정확히 한 번 호출됩니다.
+         * @note    callback은 Reader 스레드에서 실행되므로 짧게 끝내야 합니다.
+         *          (callback 안에서 GetCursorPos() 같은 동기 질의를 하면 응답을 받을 수 없어 교착됨)
+         *
+         * @code
+         *   cx::Device::Query( cx::TermQuery::MODE, 2026, []( const cx::QueryReply& r ) {
+         *       if( r.IsModeSupported() ) use_sync_output = true;
+         *   } );
+         * @endcode
+         */
+        static void Query( TermQuery query, int arg, QueryCallback callback,
+                           std::chrono::milliseconds timeout = DEFAULT_QUERY_TIMEOUT );
+
+        static void Query( TermQuery query, QueryCallback callback,
+                           std::chrono::milliseconds timeout = DEFAULT_QUERY_TIMEOUT )
+        {
+            Query( query, 0, std::move( callback ), timeout );
+        }
+
+        /// @brief [Async] 이름을 인자로 받는 질의 (TERMCAP)
+        static void Query( TermQuery query, std::string_view name, QueryCallback callback,
+                           std::chrono::milliseconds timeout = DEFAULT_QUERY_TIMEOUT );
+
         /**
          * @brief   [Thread-Safe] 현재 커서 위치를 동기적으로 요청하여 반환합니다.
-         * @details 내부적으로 입력 루프와 연동하여 커서 응답을 기다립니다.
+         * @details Query( CURSOR_POS )의 응답을 기다리는 동기 버전입니다.
          * @return  cx::Coord (성공 시), nullopt (타임아웃)
          */
         template <typename Rep, typename Period>
@@ -155,8 +475,102 @@ namespace cx
          */
         static void EnableMouse( bool enable );
 
+        /**
+         * @brief   Bracketed Paste 모드 활성화/비활성화 (ESC[?2004h)
+         * @details 활성화하면 붙여넣은 내용이 글자마다 키 이벤트로 오지 않고,
+         *          PASTE_EVENT 하나로 전달됩니다. 내용은 Event::GetPasteText()로 읽습니다.
+         *          (터미널이 보낸 그대로 전달되므로, 줄바꿈은 보통 '\r'입니다)
+         */
+        static void EnablePaste( bool enable );
+
+        /**
+         * @brief   kitty 키보드 프로토콜 활성화/비활성화 (CSI > flags u / CSI < u)
+         * @param   flags 요청할 기능 (KittyFlag 조합)
+         * @details 터미널에 기능을 요청하고 지원 여부를 질의합니다. (CSI ? u)
+         *          지원하는 터미널(kitty, foot, WezTerm, Ghostty 등)이 응답하면 그때부터 ESC 키가
+         *          CSI 27 u로 오므로, 시퀀스 앞부분과 단독 ESC를 구분하기 위한 대기 없이 즉시 전달됩니다.
+         *          지원하지 않는 터미널은 요청을 무시하므로, 기존 방식(ESC 판별 대기)으로 그대로 동작합니다.
+         * @note    KITTY_REPORT_EVENTS를 켜면 키를 뗄 때도 이벤트가 오므로, 키 입력 처리 시 IsRelease()를 확인해야 합니다.
+         */
+        static void EnableKittyKeyboard( bool enable, uint8_t flags = KITTY_DISAMBIGUATE );
+
+        /// @brief 터미널이 응답한 kitty 키보드 프로토콜 기능 (0: 미지원 또는 응답 전)
+        static uint8_t GetKeyboardFlags( void );
+
+        /**
+         * @brief   단독 ESC 키로 확정하기까지 기다리는 시간 설정
+         * @param   timeout 0: 자동 (기본값), 그 외: 고정 대기 시간
+         * @details ESC 뒤에 시퀀스가 끊겨 도착할 수 있으므로, 잠시 기다려 본 뒤 이어지지 않으면 ESC 키로 판단합니다.
+         *          자동 모드는 실제로 끊겨 도착한 시퀀스의 간격을 측정하여 대기 시간을 조정합니다.
+         *          (로컬 터미널은 수 ms, SSH처럼 느린 연결은 측정된 지연에 맞춰 늘어남)
+         *          GetInput()에 넘긴 timeout과는 무관하며, 무한 대기 중에도 ESC는 이 시간 후 전달됩니다.
+         */
+        static void SetEscTimeout( std::chrono::milliseconds timeout );
+
+        /// @brief 현재 적용 중인 ESC 판별 대기 시간 (자동 모드면 측정값에 따라 변함)
+        static std::chrono::milliseconds GetEscTimeout( void );
+
+        /// @brief 이 스레드가 GetInput()으로 마지막에 받은 마우스 이벤트의 상태
         static MouseState GetMouseState( void );
 
+        /**
+         * @brief   외부 파일 디스크립터(pty, socket, pipe, timerfd 등)를 입력 이벤트 루프에 등록/해제합니다.
+         * @param   interest 감시 조건 (FD_READ, FD_WRITE 조합)
+         * @details 등록된 fd가 준비되면 GetInput()이 FD_EVENT를 반환합니다. (Event::fd, Event::fd_ready)
+         *          데이터는 읽지 않으므로, 호출 측에서 직접 read() 해야 합니다.
+         *          (읽지 않고 두면 다음 GetInput()에서 즉시 다시 FD_EVENT가 반환됨)
+         *          FD_EVENT를 받은 구독자가 다음 대기를 시작할 때 해당 fd의 감시가 재개됩니다.
+         *          이미 등록된 fd를 다시 등록하면 감시 조건만 바뀝니다.
+         *
+         *          키 입력과 사용자 fd를 모두 하나의 GetInput() 대기로 받을 수 있으므로,
+         *          GetInput( 10ms ) 같은 주기적 폴링 없이 앱 전체를 이벤트 루프 하나로 구동할 수 있습니다.
+         * @note    UnwatchFd()는 close() 하기 전에 호출해야 합니다.
+         */
+        static void WatchFd( int fd, uint8_t interest = FD_READ );
+        static void UnwatchFd( int fd );
+
+        /**
+         * @brief   프레임 스케줄러 설정
+         * @param   fps    최대 프레임 수 (0 이하: 제한 없음, 요청 즉시 FRAME_EVENT)
+         * @param   pacing ON_DEMAND(기본) 또는 CONTINUOUS
+         * @details 렌더링 시점은 GetInput()으로 FRAME_EVENT가 전달됩니다. (timerfd 기반)
+         *          GetInput( 16ms )나 sleep_for()로 주기를 맞출 필요 없이 GetInput()으로 무한 대기하고,
+         *          상태가 바뀌었을 때 RequestFrame()만 호출하면 됩니다. 할 일이 없으면 프로세스는 깨어나지 않습니다.
+         *
+         *          - 프레임 간격은 1/fps 이상 유지되며, 한동안 그리지 않았다면 요청 즉시 그립니다.
+         *          - CONTINUOUS는 고정 격자(vsync와 유사) 위에서 틱이 발생하며,
+         *            앱이 이전 FRAME_EVENT를 아직 꺼내지 않았으면 큐에 쌓지 않고 건너뜁니다. (Event::frame_skipped)
+         *            (fps가 0 이하이면 CONTINUOUS는 무시되고 ON_DEMAND로 동작)
+         *
+         * @code
+         *   cx::Device::SetFrameRate( 60 );
+         *   while( running ) {
+         *       auto event = cx::Device::GetInput();
+         *       if( event.IsFrame() ) { Render(); continue; }
+         *       ProcessInput( event );
+         *       cx::Device::RequestFrame();
+         *   }
+         * @endcode
+         */
+        static void SetFrameRate( int fps, FramePacing pacing = FramePacing::ON_DEMAND );
+
+        /**
+         * @brief   다음 렌더링 시점에 FRAME_EVENT를 요청합니다. (여러 번 호출해도 한 프레임으로 합쳐짐)
+         * @details 아직 꺼내지 않은 FRAME_EVENT가 큐에 있으면, 그 프레임이 최신 상태를 그리므로 새로 만들지 않습니다.
+         */
+        static void RequestFrame( void ) { GetPtr()->RequestFrameAt( std::chrono::steady_clock::time_point{} ); }
+
+        /**
+         * @brief   delay 후에 FRAME_EVENT를 요청합니다. (시계 갱신, 커서 깜빡임 등 예약 렌더링)
+         * @note    지연 요청은 가장 이른 시각 하나만 보관합니다. 주기적으로 필요하면 프레임을 그린 뒤 다시 요청하세요.
+         */
+        template <typename Rep, typename Period>
+        static void RequestFrame( const std::chrono::duration<Rep, Period>& delay )
+        {
+            auto due = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>( delay );
+            GetPtr()->RequestFrameAt( due );
+        }
+
         // --- Flow Control ---
         static void ForcePause( void ); // Raw Mode 일시 해제
         static void Resume( void );     // Raw Mode 재진입
@@ -182,8 +596,29 @@ namespace cx
 
         void Init( void );
 
-        // 내부 입력 처리 (점유 플래그 관리)
-        std::optional<DeviceInputCode> GetInputMs( const int timeout_ms );
+        // 내부 입력 처리 (기본 구독에서 꺼냄)
+        std::optional<Event> GetInputMs( const int timeout_ms );
+        size_t GetEventsMs( std::span<Event> out, const int timeout_ms );
+
+        // Reader 스레드
+        void EnsureReaderThread( void );
+        void EnsureDefaultSub( void );
+        void EnsureRawMode( void );
+        void ReaderLoop( void );
+        void ParseAndPublish( void );
+        void Publish( Event event );
+        void Notify( uint32_t bits );
+
+        // 구독 관리
+        void AddChannel( const std::shared_ptr<Channel>& channel );
+        void Unsubscribe( const std::shared_ptr<Channel>& channel );
+        void RearmFds( Channel& channel );
+
+        // 프레임 스케줄러
+        void RequestFrameAt( std::chrono::steady_clock::time_point due );
+        void ArmFrameTimer( std::chrono::steady_clock::time_point at );
+        void OnFrameTimer( void );
+        bool PublishFrame( const Event& event );
 
         // Raw Mode 제어
         void SetRawModeWithLock( const bool enable );
@@ -193,21 +628,54 @@ namespace cx
         void ResetTerminalMode( void );
 
         // 파서
-        std::pair<DeviceInputCode, size_t> ParseInputBuffer  ( const std::string& buf );
-        std::pair<DeviceInputCode, size_t> ParseMouseSequence( const std::string& buf );
+        std::pair<DeviceInputCode, size_t> ParseInputBuffer  ( std::string_view buf );
+        std::pair<DeviceInputCode, size_t> ParseCsiSequence  ( std::string_view buf );
+        std::pair<DeviceInputCode, size_t> ParseStringReply  ( std::string_view buf );
+        std::pair<DeviceInputCode, size_t> ParseUtf8Char     ( std::string_view buf );
+        DeviceInputCode                    ParseKittyKey     ( std::string_view params );
+
+        // ESC 판별 대기 시간 추정 (Reader 스레드 전용)
+        void OnInputReceived( std::string_view data );
+        void AddEscLatencySample( double sample_ms );
+        std::pair<DeviceInputCode, size_t> ParseMouseSequence( std::string_view buf );
 
         // 시그널 핸들러
         static void HandleSignal( int sig );
 
-        // 커서 위치 요청 내부 구현
+        // 터미널 질의 (응답 짝짓기, 타임아웃 처리)
         std::optional<Coord> GetCursorPosMs( const int timeout_ms );
-        void RequestCursorPos( void );
+        void SendQuery( TermQuery query, int arg, std::string name, QueryCallback callback, std::chrono::milliseconds timeout );
+        bool HasPendingQuery( TermQuery query );
+        bool IsAwaitingStringReply( std::string_view buf );
+        bool CompleteQuery( QueryReply reply );
+        void ExpireQueries( std::chrono::steady_clock::time_point now );
+        std::chrono::steady_clock::time_point NextQueryDeadline( void );
 
     private:
-        static constexpr uint64_t EVENT_CODE_INTERRUPT = 1;
-        static constexpr uint64_t EVENT_CODE_RESIZE    = 2;
+        // Reader 스레드에 전달할 이벤트 비트 (eventfd 값이 아니라 pending 비트로 누적)
+        static constexpr uint32_t EVENT_CODE_INTERRUPT = 1;
+        static constexpr uint32_t EVENT_CODE_RESIZE    = 2;
+        static constexpr uint32_t EVENT_CODE_WAKEUP    = 4; // Raw Mode 전환 등으로 epoll_wait() 재시작
+        static constexpr uint32_t EVENT_CODE_STOP      = 8; // Reader 스레드 종료
+
+        // 이스케이프 시퀀스가 끊겨 도착할 때, 단독 ESC 키로 확정하기까지 기다리는 시간 (자동 모드 범위와 초기값)
+        static constexpr int ESC_TIMEOUT_MIN_MS    = 5;
+        static constexpr int ESC_TIMEOUT_MAX_MS    = 500;
+        static constexpr int ESC_TIMEOUT_LOCAL_MS  = 10; // 로컬 터미널 (시퀀스가 거의 끊기지 않음)
+        static constexpr int ESC_TIMEOUT_REMOTE_MS = 50; // SSH 접속 (첫 측정 전까지의 보수적인 값)
+
+        // Bracketed Paste 시작/끝 표시
+        static constexpr std::string_view PASTE_BEGIN = "\033[200~";
+        static constexpr std::string_view PASTE_END   = "\033[201~";
+
+        // STDIN 수신 버퍼 크기 (read() 한 번에 읽을 수 있는 최대량)
+        static constexpr size_t INPUT_RING_CAPACITY = 16 * 1024;
+
+        // 종료 시 터미널 복구 전에 남은 화면 출력을 기다리는 최대 시간
+        static constexpr std::chrono::milliseconds EXIT_DRAIN_TIMEOUT { 1000 };
 
         int               event_fd_;
+        int               epoll_fd_;
         struct termios    orig_termios_;
         std::atomic<bool> is_raw_mode_;
         std::mutex        mtx_;
@@ -215,15 +683,72 @@ namespace cx
         struct sigaction old_sa_winch_;
         struct sigaction old_sa_int_;
 
+        // 파서 상태 (Reader 스레드 전용)
         MouseState  last_mouse_state_;
         Coord       last_cursor_pos_;
+        uint8_t     last_key_mods_;  // 파싱 중인 키의 수식 키 (KeyMod)
+        uint32_t    last_codepoint_; // 파싱 중인 키의 문자
+        KeyAction   last_key_action_; // 파싱 중인 키의 누름/반복/뗌
+
+        // ESC 판별 대기 시간 (자동 모드: 끊긴 시퀀스의 도착 간격을 TCP RTO처럼 평균 + 4 * 편차로 추정)
+        std::atomic<int> esc_fixed_ms_   { 0 };  // 0: 자동
+        std::atomic<int> esc_timeout_ms_ { 0 };  // 현재 적용 값
+        double           esc_srtt_ms_    = 0.0;  // 평활 평균
+        double           esc_rttvar_ms_  = 0.0;  // 평활 편차
+        bool             esc_has_sample_ = false;
+        bool             esc_guessed_    = false; // 직전 ESC를 타임아웃으로 확정함 (뒤늦게 나머지가 오면 측정)
+        std::chrono::steady_clock::time_point esc_guess_time_; // 그 ESC를 수신한 시각
         bool        is_mouse_tracking_;
-        std::string input_buf_;
-
-        // Thread Safety
-        std::atomic<bool>    is_input_running_;
-        std::mutex           cursor_promise_mtx_;
-        std::promise<Coord>* cursor_promise_;
+        bool        is_paste_enabled_;
+        std::atomic<uint8_t> kitty_requested_ { 0 }; // EnableKittyKeyboard()로 요청한 기능 (0: 꺼짐, 앱 스레드가 쓰고 Reader 스레드가 읽음)
+        std::atomic<uint8_t> kitty_flags_ { 0 }; // 터미널이 응답한 기능 (0이 아니면 ESC 판별 대기 없음)
+        bool        in_paste_;   // PASTE_BEGIN ~ PASTE_END 사이를 수신 중
+        std::string paste_buf_;  // 수신 중인 붙여넣기 내용
+        ByteRing    input_ring_; // read()가 직접 쓰고, 파서가 string_view로 읽는 수신 버퍼
+        std::chrono::steady_clock::time_point input_time_; // input_ring_에 마지막으로 읽어 들인 시각
+
+        // 사용자 등록 fd 목록 (epoll 재등록 시 감시 조건 참조)
+        struct WatchedFd { int fd; uint8_t interest; };
+        std::mutex             watch_mtx_;
+        std::vector<WatchedFd> watch_fds_;
+
+        // 프레임 스케줄러 (timerfd, frame_mtx_로 보호)
+        using TimePoint = std::chrono::steady_clock::time_point;
+        int                                 frame_fd_       = -1;
+        std::mutex                          frame_mtx_;
+        std::chrono::steady_clock::duration frame_interval_ {};                         // 0: 제한 없음
+        FramePacing                         frame_pacing_   = FramePacing::ON_DEMAND;
+        bool                                frame_asap_     = false;                    // 즉시 요청 대기 중
+        TimePoint                           frame_due_      = TimePoint::max();         // 지연 요청 시각 (max: 없음)
+        TimePoint                           frame_armed_at_ = TimePoint::max();         // 타이머 만료 예정 시각 (max: 꺼짐)
+        TimePoint                           last_frame_     = {};
+        uint64_t                            frame_count_    = 0;
+        uint32_t                            frame_skipped_  = 0;
+
+        // Reader 스레드
+        std::thread       reader_;
+        std::once_flag    reader_once_;
+
+        // 구독자 목록 (Copy-On-Write: Reader는 스냅샷을 atomic load로 읽음)
+        using ChannelList = std::vector<std::shared_ptr<Channel>>;
+        std::mutex                         subs_mtx_;
+        std::shared_ptr<const ChannelList> channels_;
+
+        // GetInput()용 기본 구독 (처음 GetInput()/GetEvents() 호출 시 생성)
+        std::once_flag default_once_;
+        Subscription   default_sub_;
+
+        // 응답 대기 중인 터미널 질의 (요청 순서대로 보관, 같은 종류는 먼저 보낸 것부터 짝지음)
+        struct PendingQuery
+        {
+            TermQuery                             query;
+            int                                   arg;
+            std::string                           name;
+            QueryCallback                         callback;
+            std::chrono::steady_clock::time_point deadline;
+        };
+        std::mutex               query_mtx_;
+        std::deque<PendingQuery> queries_;
     };
 
 } // namespace cx
@@ -0,0 +1,231 @@
+#ifndef _CONSOLE_X_KEYMAP_HPP_
+#define _CONSOLE_X_KEYMAP_HPP_
+
+/** ------------------------------------------------------------------------------------
+ *  ConsoleX Key Sequence Table
+ *  ------------------------------------------------------------------------------------
+ *  터미널별 키 이스케이프 시퀀스 표와, 이 표로부터 컴파일 타임에 만들어지는 Trie입니다.
+ *  새 터미널을 지원하려면 KEY_SEQUENCES에 한 줄을 추가하면 됩니다.
+ *  (겹치거나 서로의 접두사가 되는 시퀀스는 static_assert로 컴파일 시 거부됨)
+ *  ------------------------------------------------------------------------------------ */
+
+#include "cx_device.hpp" // DeviceInputCode
+
+#include <array>       // std::array
+#include <cstdint>     // int16_t
+#include <string_view> // std::string_view
+
+namespace cx
+{
+    struct KeySequence
+    {
+        std::string_view seq;              // 터미널이 보내는 바이트열
+        DeviceInputCode  code;             // 변환할 키 (NONE: 소비하고 무시)
+        uint8_t          mods = MOD_NONE;  // 시퀀스 자체에 담긴 수식 키 (KeyMod)
+    };
+
+    // =========================================================================
+    // Key Sequence Table
+    // =========================================================================
+
+    inline constexpr KeySequence KEY_SEQUENCES[] =
+    {
+        // --- xterm / VT100 (Normal Cursor Mode: CSI) ---
+        { "\033[A",   DeviceInputCode::ARROW_UP    },
+        { "\033[B",   DeviceInputCode::ARROW_DOWN  },
+        { "\033[C",   DeviceInputCode::ARROW_RIGHT },
+        { "\033[D",   DeviceInputCode::ARROW_LEFT  },
+        { "\033[H",   DeviceInputCode::HOME        },
+        { "\033[F",   DeviceInputCode::END         },
+
+        // --- xterm / VT100 (Application Cursor Mode: SS3) ---
+        { "\033OA",   DeviceInputCode::ARROW_UP    },
+        { "\033OB",   DeviceInputCode::ARROW_DOWN  },
+        { "\033OC",   DeviceInputCode::ARROW_RIGHT },
+        { "\033OD",   DeviceInputCode::ARROW_LEFT  },
+        { "\033OH",   DeviceInputCode::HOME        },
+        { "\033OF",   DeviceInputCode::END         },
+
+        // --- VT100 / xterm: F1 ~ F4 (SS3) ---
+        { "\033OP",   DeviceInputCode::F1 },
+        { "\033OQ",   DeviceInputCode::F2 },
+        { "\033OR",   DeviceInputCode::F3 },
+        { "\033OS",   DeviceInputCode::F4 },
+
+        // --- VT220 / xterm: 편집 키, F5 ~ F12 ---
+        { "\033[2~",  DeviceInputCode::INSERT    },
+        { "\033[3~",  DeviceInputCode::DEL       },
+        { "\033[5~",  DeviceInputCode::PAGE_UP   },
+        { "\033[6~",  DeviceInputCode::PAGE_DOWN },
+        { "\033[15~", DeviceInputCode::F5  },
+        { "\033[17~", DeviceInputCode::F6  },
+        { "\033[18~", DeviceInputCode::F7  },
+        { "\033[19~", DeviceInputCode::F8  },
+        { "\033[20~", DeviceInputCode::F9  },
+        { "\033[21~", DeviceInputCode::F10 },
+        { "\033[23~", DeviceInputCode::F11 },
+        { "\033[24~", DeviceInputCode::F12 },
+
+        // --- Tera Term / rxvt / VT220: Home, End, F1 ~ F4 ---
+        { "\033[1~",  DeviceInputCode::HOME },
+        { "\033[4~",  DeviceInputCode::END  },
+        { "\033[11~", DeviceInputCode::F1   },
+        { "\033[12~", DeviceInputCode::F2   },
+        { "\033[13~", DeviceInputCode::F3   }, // kitty도 F3는 이 형식 사용 (CSI R은 커서 위치 응답과 겹침)
+        { "\033[14~", DeviceInputCode::F4   },
+
+        // --- rxvt: Home, End ---
+        { "\033[7~",  DeviceInputCode::HOME },
+        { "\033[8~",  DeviceInputCode::END  },
+
+        // --- rxvt: Shift / Ctrl + 화살표 ---
+        { "\033[a",   DeviceInputCode::ARROW_UP,    MOD_SHIFT },
+        { "\033[b",   DeviceInputCode::ARROW_DOWN,  MOD_SHIFT },
+        { "\033[c",   DeviceInputCode::ARROW_RIGHT, MOD_SHIFT },
+        { "\033[d",   DeviceInputCode::ARROW_LEFT,  MOD_SHIFT },
+        { "\033Oa",   DeviceInputCode::ARROW_UP,    MOD_CTRL  },
+        { "\033Ob",   DeviceInputCode::ARROW_DOWN,  MOD_CTRL  },
+        { "\033Oc",   DeviceInputCode::ARROW_RIGHT, MOD_CTRL  },
+        { "\033Od",   DeviceInputCode::ARROW_LEFT,  MOD_CTRL  },
+
+        // --- xterm: Shift + Tab ---
+        { "\033[Z",   DeviceInputCode::TAB, MOD_SHIFT },
+
+        // --- Linux Console: F1 ~ F5 ---
+        { "\033[[A",  DeviceInputCode::F1 },
+        { "\033[[B",  DeviceInputCode::F2 },
+        { "\033[[C",  DeviceInputCode::F3 },
+        { "\033[[D",  DeviceInputCode::F4 },
+        { "\033[[E",  DeviceInputCode::F5 },
+
+        // --- kitty (Legacy Mode): F1, F2, F4 (CSI) ---
+        { "\033[P",   DeviceInputCode::F1 },
+        { "\033[Q",   DeviceInputCode::F2 },
+        { "\033[S",   DeviceInputCode::F4 },
+
+        // --- Focus In/Out (xterm ?1004) : 무시 ---
+        { "\033[I",   DeviceInputCode::NONE },
+        { "\033[O",   DeviceInputCode::NONE },
+    };
+
+    // =========================================================================
+    // Compile-Time Trie
+    // =========================================================================
+
+    /**
+     * @brief 키 시퀀스 Trie (constexpr 생성, 조회 시 메모리 할당/예외 없음)
+     *
+     * @details
+     *   각 노드는 첫 자식과 다음 형제 인덱스로 연결됩니다. (바이트당 형제 수는 많아야 수십 개)
+     *   Find()는 버퍼 앞부분을 한 바이트씩 따라가며 다음 중 하나를 반환합니다.
+     *   - MATCH    : 표의 시퀀스와 일치 (code, length 유효)
+     *   - PARTIAL  : 지금까지는 일치하지만 데이터가 더 필요
+     *   - NO_MATCH : 표에 없는 시퀀스 (호출 측에서 일반 규칙으로 처리)
+     */
+    template <size_t MaxNodes>
+    class KeyTrie
+    {
+    public:
+        enum class Result { MATCH, PARTIAL, NO_MATCH };
+
+        struct Match
+        {
+            Result          result = Result::NO_MATCH;
+            DeviceInputCode code   = DeviceInputCode::NONE;
+            size_t          length = 0;
+            uint8_t         mods   = MOD_NONE;
+        };
+
+        template <size_t N>
+        constexpr explicit KeyTrie( const KeySequence ( &table )[N] )
+        {
+            for( const auto& entry : table ) Insert( entry );
+        }
+
+        constexpr Match Find( std::string_view buf ) const
+        {
+            int16_t node = 0;
+            for( size_t i = 0; i < buf.size(); ++i )
+            {
+                node = FindChild( node, buf[i] );
+                if( node < 0 ) return { Result::NO_MATCH };
+
+                if( nodes_[node].is_end ) return { Result::MATCH, nodes_[node].code, i + 1, nodes_[node].mods };
+            }
+            return { Result::PARTIAL };
+        }
+
+        /// @brief 표에 중복/접두사 충돌이 없는지 (static_assert용)
+        constexpr bool IsValid( void ) const { return valid_; }
+
+        constexpr size_t NodeCount( void ) const { return count_; }
+
+    private:
+        struct Node
+        {
+            char            byte         = 0;
+            bool            is_end       = false;
+            DeviceInputCode code         = DeviceInputCode::NONE;
+            uint8_t         mods         = MOD_NONE;
+            int16_t         first_child  = -1;
+            int16_t         next_sibling = -1;
+        };
+
+        constexpr int16_t FindChild( int16_t node, char byte ) const
+        {
+            for( int16_t c = nodes_[node].first_child; c >= 0; c = nodes_[c].next_sibling ) {
+                if( nodes_[c].byte == byte ) return c;
+            }
+            return -1;
+        }
+
+        constexpr void Insert( const KeySequence& entry )
+        {
+            if( entry.seq.empty() ) { valid_ = false; return; }
+
+            int16_t node = 0;
+            for( char byte : entry.seq )
+            {
+                // 더 짧은 시퀀스가 이미 여기서 끝남 (접두사 충돌)
+                if( nodes_[node].is_end ) { valid_ = false; return; }
+
+                int16_t child = FindChild( node, byte );
+                if( child < 0 )
+                {
+                    child = static_cast<int16_t>( count_++ );
+                    nodes_[child].byte         = byte;
+                    nodes_[child].next_sibling = nodes_[node].first_child;
+                    nodes_[node].first_child   = child;
+                }
+                node = child;
+            }
+
+            // 중복이거나, 이 시퀀스가 다른 시퀀스의 접두사
+            if( nodes_[node].is_end || nodes_[node].first_child >= 0 ) { valid_ = false; return; }
+
+            nodes_[node].is_end = true;
+            nodes_[node].code   = entry.code;
+            nodes_[node].mods   = entry.mods;
+        }
+
+        std::array<Node, MaxNodes> nodes_ {};
+        size_t                     count_ = 1; // 0번은 루트
+        bool                       valid_ = true;
+    };
+
+    /// @brief 표 전체 바이트 수 + 루트 (노드 수의 상한)
+    template <size_t N>
+    constexpr size_t KeyTrieCapacity( const KeySequence ( &table )[N] )
+    {
+        size_t total = 1;
+        for( const auto& entry : table ) total += entry.seq.size();
+        return total;
+    }
+
+    inline constexpr KeyTrie<KeyTrieCapacity( KEY_SEQUENCES )> KEY_TRIE { KEY_SEQUENCES };
+
+    static_assert( KEY_TRIE.IsValid(), "KEY_SEQUENCES has duplicate or prefix-overlapping sequences" );
+
+} // namespace cx
+
+#endif // _CONSOLE_X_KEYMAP_HPP_
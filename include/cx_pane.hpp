@@ -0,0 +1,206 @@
+#ifndef _CONSOLE_X_PANE_HPP_
+#define _CONSOLE_X_PANE_HPP_
+
+/** ------------------------------------------------------------------------------------
+ *  ConsoleX Terminal Pane Module
+ *  ------------------------------------------------------------------------------------
+ *  pty(forkpty) 위에서 자식 프로세스(셸, tail -f 등)를 실행하고,
+ *  그 출력을 자체 VT 파서로 해석하여 cx::Buffer의 일부 영역에 그리는 패널입니다.
+ *  ------------------------------------------------------------------------------------ */
+
+#include "cx_buffer.hpp"
+#include "cx_device.hpp"
+#include "cx_util.hpp"
+
+#include <sys/types.h> // pid_t
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cx
+{
+    /**
+     * @brief pty 기반 터미널 에뮬레이터 패널
+     *
+     * @details
+     *   - 자식 프로세스의 pty master fd는 cx::Device::WatchFd()로 등록되므로,
+     *     출력이 생기면 GetInput()이 FD_EVENT를 반환합니다. 이때 Pump()를 호출하세요.
+     *   - Pump()는 한 번에 읽는 양(max_bytes)을 제한하여, 출력이 많은 자식 프로세스가
+     *     UI 루프를 독점하지 못하게 합니다. 남은 데이터는 다음 FD_EVENT에서 처리됩니다.
+     *   - 화면 갱신은 Render() 호출 시점에 한 번에 반영되므로, 여러 번 Pump() 후
+     *     프레임마다 한 번만 Render() 하면 됩니다. (IsDirty()로 변경 여부 확인)
+     *   - 화면 위로 밀려난 줄은 고정 크기 링 버퍼(Scrollback)에 보관됩니다.
+     */
+    class TermPane
+    {
+    public:
+        static constexpr size_t DEFAULT_PUMP_BUDGET = 64 * 1024; // Pump() 1회 최대 읽기량
+
+        /**
+         * @param cols       패널 너비
+         * @param rows       패널 높이
+         * @param scrollback 보관할 최대 과거 줄 수 (0: 보관 안 함)
+         */
+        TermPane( int cols, int rows, size_t scrollback = 1000 );
+        ~TermPane();
+
+        TermPane( const TermPane& ) = delete;
+        TermPane& operator=( const TermPane& ) = delete;
+
+        // --- Process ---------------------------------------------------------
+
+        /**
+         * @brief  자식 프로세스를 pty에서 실행합니다.
+         * @param  argv 실행할 명령과 인자 (비어 있으면 $SHELL, 없으면 /bin/sh)
+         * @return 성공 시 true
+         */
+        bool Spawn( const std::vector<std::string>& argv = {} );
+
+        /// @brief 자식 프로세스를 종료(SIGHUP)하고 pty를 닫습니다.
+        void Terminate( void );
+
+        /// @brief 자식 프로세스가 실행 중인지 확인합니다.
+        bool IsRunning( void );
+
+        /// @brief 종료된 자식 프로세스의 waitpid() 상태값 (실행 중이면 -1)
+        int GetExitStatus( void ) const { return exit_status_; }
+
+        /// @brief pty master fd (실행 중이 아니면 -1)
+        int GetFd( void ) const { return master_fd_; }
+
+        // --- I/O -------------------------------------------------------------
+
+        /**
+         * @brief  pty에서 읽을 수 있는 출력을 최대 max_bytes만큼 읽어 화면에 반영합니다.
+         * @return 처리한 바이트 수 (넌블로킹: 읽을 것이 없으면 즉시 0 반환)
+         */
+        size_t Pump( size_t max_bytes = DEFAULT_PUMP_BUDGET );
+
+        /// @brief VT 데이터를 직접 파서에 입력합니다. (pty 없이 로그 재생 등에 사용)
+        void Feed( std::string_view data );
+
+        /// @brief 자식 프로세스의 입력으로 바이트를 그대로 보냅니다.
+        void SendInput( std::string_view bytes );
+
+        /// @brief cx::Device 키 코드를 터미널 시퀀스로 변환하여 보냅니다.
+        void SendKey( DeviceInputCode key );
+
+        /// @brief 키 이벤트를 수식 키(Ctrl/Alt/Shift)와 UTF-8 문자까지 포함하여 보냅니다. (xterm 방식)
+        void SendKey( const Device::Event& event );
+
+        /// @brief 붙여넣기 내용을 보냅니다. (자식이 Bracketed Paste를 켰으면 시작/끝 표시로 감쌈)
+        void SendPaste( std::string_view text );
+
+        // --- View ------------------------------------------------------------
+
+        /// @brief 패널 크기를 변경하고 자식 프로세스에 알립니다. (TIOCSWINSZ)
+        void Resize( int cols, int rows );
+
+        /// @brief 스크롤백 보기 위치 이동 (+: 과거 방향, -: 최신 방향)
+        void ScrollView( int lines );
+
+        /// @brief 스크롤백 보기를 해제하고 최신 화면으로 돌아갑니다.
+        void ResetView( void ) { ScrollView( -view_offset_ ); }
+
+        int    GetScrollOffset( void ) const { return view_offset_; }
+        size_t GetScrollbackSize( void ) const { return history_count_; }
+        int    GetCols( void ) const { return cols_; }
+        int    GetRows( void ) const { return rows_; }
+
+        /// @brief 마지막 Render() 이후 화면 내용이 바뀌었는지 확인
+        bool IsDirty( void ) const { return is_dirty_; }
+
+        /// @brief OSC 0/2로 설정된 창 제목
+        const std::string& GetTitle( void ) const { return title_; }
+
+        /// @brief 패널 내용을 buffer의 (x, y) 위치에 그립니다.
+        void Render( Buffer& buffer, int x, int y );
+
+    private:
+        using Row = std::vector<Cell>;
+
+        // VT 처리
+        void HandleToken( const AnsiTokenizer::Token& token );
+        void HandleControl( char c );
+        void HandleEsc( const AnsiTokenizer::Token& token );
+        void HandleCsi( const AnsiTokenizer::Token& token );
+        void HandleMode( const AnsiTokenizer::Token& token, bool enable );
+        void PrintRun( std::string_view run );
+        void PrintChar( const char* bytes, size_t len, uint32_t codepoint );
+
+        // 화면 조작
+        Cell BlankCell( void ) const;
+        void ClearRow( Row& row );
+        void EraseCells( int y, int from, int to );
+        void LineFeed( void );
+        void ReverseIndex( void );
+        void ScrollUp( int top, int bottom, int count, bool to_history ); // to_history: 밀려난 줄을 스크롤백에 보관
+        bool ScrollsToHistory( void ) const;
+        void ScrollDown( int top, int bottom, int count );
+        void SetCursor( int x, int y );
+        void SwitchAltScreen( bool enable );
+        void ResizeGrid( std::vector<Row>& grid, int cols, int rows );
+
+        // 스크롤백 링 버퍼
+        void PushHistory( Row& row );
+        const Row& HistoryAt( size_t index ) const;
+
+        // 자식 프로세스 관리
+        void Reply( std::string_view bytes );
+        void CloseMaster( void );
+        void ReapChild( bool block );
+
+    private:
+        int   cols_;
+        int   rows_;
+
+        // 프로세스
+        pid_t pid_         = -1;
+        int   master_fd_   = -1;
+        int   exit_status_ = -1;
+
+        // 화면
+        std::vector<Row> screen_;
+        std::vector<Row> alt_screen_;  // 대체 화면 사용 시 원래 화면 보관
+        bool             is_alt_screen_ = false;
+
+        // 스크롤백 (링 버퍼)
+        std::vector<Row> history_;
+        size_t           history_limit_;
+        size_t           history_head_  = 0;
+        size_t           history_count_ = 0;
+        int              view_offset_   = 0;
+
+        // 커서 & 스타일
+        int       cur_x_        = 0;
+        int       cur_y_        = 0;
+        bool      wrap_pending_ = false;
+        TextStyle style_;
+        TextStyle base_style_;
+
+        struct SavedCursor { int x = 0; int y = 0; TextStyle style; };
+        SavedCursor saved_cursor_;
+
+        // 스크롤 영역 (DECSTBM)
+        int scroll_top_    = 0;
+        int scroll_bottom_ = 0;
+
+        // 모드
+        bool autowrap_       = true;  // DECAWM
+        bool insert_mode_    = false; // IRM
+        bool app_cursor_     = false; // DECCKM
+        bool cursor_visible_ = true;  // DECTCEM
+        bool bracketed_paste_ = false;
+
+        // 파서
+        AnsiTokenizer tokenizer_;
+        char          utf8_carry_[4] = {};
+        size_t        utf8_carry_len_ = 0;
+
+        std::string title_;
+        bool        is_dirty_ = true;
+    };
+
+} // namespace cx
+
+#endif // _CONSOLE_X_PANE_HPP_
@@ -0,0 +1,186 @@
+#ifndef _CONSOLE_X_QUEUE_HPP_
+#define _CONSOLE_X_QUEUE_HPP_
+
+/** ------------------------------------------------------------------------------------
+ *  ConsoleX Queue Module
+ *  ------------------------------------------------------------------------------------
+ *  - MpmcQueue : 스레드 간 이벤트 전달에 사용하는 고정 크기 Lock-Free MPMC 큐
+ *                (Dmitry Vyukov의 Bounded MPMC Queue 알고리즘)
+ *  - ByteRing  : 입력 스트림을 복사/삭제 없이 쌓고 파싱하는 고정 크기 바이트 버퍼
+ *  ------------------------------------------------------------------------------------ */
+
+#include <atomic>      // std::atomic
+#include <memory>      // std::unique_ptr
+#include <cstddef>     // size_t
+#include <cstdint>     // intptr_t
+#include <cstring>     // memmove
+#include <algorithm>   // std::min
+#include <utility>     // std::move
+#include <string_view> // std::string_view
+#include <span>        // std::span
+
+namespace cx
+{
+    /**
+     * @brief 고정 용량 Lock-Free MPMC(Multi-Producer Multi-Consumer) 큐
+     *
+     * @details
+     *   - 각 슬롯의 시퀀스 번호로 생산자/소비자가 슬롯 소유권을 CAS 한 번으로 얻습니다.
+     *   - 생성 이후 메모리 할당이 없으며, 가득 차면 TryPush()가 false를 반환합니다.
+     *   - 용량은 2의 거듭제곱으로 올림됩니다. (인덱스 계산을 비트 마스크로 처리)
+     *   - 대기(Blocking) 기능은 없으므로, 필요하면 호출 측에서 조건 변수 등과 조합합니다.
+     */
+    template <typename T>
+    class MpmcQueue
+    {
+    public:
+        explicit MpmcQueue( size_t capacity )
+        {
+            size_t size = 2;
+            while( size < capacity ) size <<= 1;
+
+            mask_  = size - 1;
+            slots_ = std::make_unique<Slot[]>( size );
+            for( size_t i = 0; i < size; ++i ) {
+                slots_[i].seq.store( i, std::memory_order_relaxed );
+            }
+        }
+
+        MpmcQueue( const MpmcQueue& ) = delete;
+        MpmcQueue& operator=( const MpmcQueue& ) = delete;
+
+        /// @brief 값을 넣습니다. 큐가 가득 찼으면 false
+        template <typename U>
+        bool TryPush( U&& value )
+        {
+            size_t pos = tail_.load( std::memory_order_relaxed );
+            Slot*  slot;
+
+            while( true )
+            {
+                slot = &slots_[pos & mask_];
+                size_t   seq  = slot->seq.load( std::memory_order_acquire );
+                intptr_t diff = static_cast<intptr_t>( seq ) - static_cast<intptr_t>( pos );
+
+                if( diff == 0 ) {
+                    // 빈 슬롯: tail을 선점하면 이 슬롯은 내 것
+                    if( tail_.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) break;
+                }
+                else if( diff < 0 ) {
+                    return false; // 가득 참 (소비자가 아직 비우지 않은 슬롯)
+                }
+                else {
+                    pos = tail_.load( std::memory_order_relaxed ); // 다른 생산자가 앞섬
+                }
+            }
+
+            slot->value = std::forward<U>( value );
+            slot->seq.store( pos + 1, std::memory_order_release );
+            return true;
+        }
+
+        /// @brief 값을 꺼냅니다. 큐가 비었으면 false
+        bool TryPop( T& out )
+        {
+            size_t pos = head_.load( std::memory_order_relaxed );
+            Slot*  slot;
+
+            while( true )
+            {
+                slot = &slots_[pos & mask_];
+                size_t   seq  = slot->seq.load( std::memory_order_acquire );
+                intptr_t diff = static_cast<intptr_t>( seq ) - static_cast<intptr_t>( pos + 1 );
+
+                if( diff == 0 ) {
+                    if( head_.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) break;
+                }
+                else if( diff < 0 ) {
+                    return false; // 비어 있음
+                }
+                else {
+                    pos = head_.load( std::memory_order_relaxed );
+                }
+            }
+
+            out = std::move( slot->value );
+            slot->seq.store( pos + mask_ + 1, std::memory_order_release ); // 다음 바퀴의 생산자에게 반환
+            return true;
+        }
+
+        size_t Capacity( void ) const { return mask_ + 1; }
+
+    private:
+        struct Slot {
+            std::atomic<size_t> seq;
+            T                   value;
+        };
+
+        std::unique_ptr<Slot[]> slots_;
+        size_t                  mask_ = 0;
+
+        // 생산자/소비자 인덱스를 서로 다른 캐시 라인에 두어 False Sharing 방지
+        alignas(64) std::atomic<size_t> head_ { 0 };
+        alignas(64) std::atomic<size_t> tail_ { 0 };
+    };
+
+    /**
+     * @brief 고정 용량 바이트 링 버퍼 (단일 스레드 전용)
+     *
+     * @details
+     *   - read()가 WritableSpan()에 직접 쓰고 Commit() 하므로, 중간 복사 버퍼가 없습니다.
+     *   - 파서는 Peek()로 아직 소비하지 않은 구간을 string_view로 보고, 처리한 만큼 Consume() 합니다.
+     *     (std::string::erase(0, n)처럼 소비할 때마다 남은 데이터를 당기지 않음)
+     *   - 쓰기 위치가 끝에 닿으면 그때만 남은 조각을 앞으로 옮깁니다.
+     *     남은 조각은 보통 덜 도착한 시퀀스 하나 분량이므로, 전체 비용은 받은 바이트 수에 비례합니다.
+     *     (파서가 항상 연속된 구간을 볼 수 있도록, 감싸 도는 대신 이 방식을 사용)
+     */
+    class ByteRing
+    {
+    public:
+        explicit ByteRing( size_t capacity )
+            : data_( std::make_unique<char[]>( capacity ) ), capacity_( capacity ) {}
+
+        ByteRing( const ByteRing& ) = delete;
+        ByteRing& operator=( const ByteRing& ) = delete;
+
+        /// @brief 아직 소비하지 않은 데이터 (다음 Commit/WritableSpan 호출 전까지 유효)
+        std::string_view Peek( void ) const { return { data_.get() + read_, write_ - read_ }; }
+
+        /// @brief 앞에서부터 n 바이트를 소비합니다.
+        void Consume( size_t n )
+        {
+            read_ += std::min( n, write_ - read_ );
+            if( read_ == write_ ) read_ = write_ = 0; // 비면 처음부터 다시 사용 (이동 비용 없음)
+        }
+
+        /// @brief 이어서 쓸 수 있는 공간 (끝에 닿았으면 남은 조각을 앞으로 옮겨 확보)
+        std::span<char> WritableSpan( void )
+        {
+            if( write_ == capacity_ && read_ > 0 ) {
+                size_t remain = write_ - read_;
+                memmove( data_.get(), data_.get() + read_, remain );
+                read_  = 0;
+                write_ = remain;
+            }
+            return { data_.get() + write_, capacity_ - write_ };
+        }
+
+        /// @brief WritableSpan()에 쓴 n 바이트를 데이터로 확정합니다.
+        void Commit( size_t n ) { write_ += std::min( n, capacity_ - write_ ); }
+
+        void   Clear   ( void )       { read_ = write_ = 0; }
+        bool   Empty   ( void ) const { return read_ == write_; }
+        bool   Full    ( void ) const { return read_ == 0 && write_ == capacity_; }
+        size_t Size    ( void ) const { return write_ - read_; }
+        size_t Capacity( void ) const { return capacity_; }
+
+    private:
+        std::unique_ptr<char[]> data_;
+        size_t                  capacity_;
+        size_t                  read_  = 0; // 파싱 위치
+        size_t                  write_ = 0; // 수신 위치
+    };
+
+} // namespace cx
+
+#endif // _CONSOLE_X_QUEUE_HPP_
@@ -0,0 +1,112 @@
+#ifndef _CONSOLE_X_RENDERER_HPP_
+#define _CONSOLE_X_RENDERER_HPP_
+
+/** ------------------------------------------------------------------------------------
+ *  ConsoleX Render Thread
+ *  ------------------------------------------------------------------------------------
+ *  앱 스레드는 프레임을 cx::Buffer에 그려서 Submit()만 하고, 전용 Writer 스레드가
+ *  변경 부분 계산(Diff)과 터미널 출력을 맡습니다.
+ *
+ *  SSH처럼 출력이 느린 환경에서 Flush()가 pty 버퍼가 빌 때까지 막히더라도,
+ *  앱 스레드는 계속 입력을 처리하고 다음 프레임을 그릴 수 있습니다.
+ *  ------------------------------------------------------------------------------------ */
+
+#include "cx_buffer.hpp"
+
+#include <array>       // std::array
+#include <atomic>      // std::atomic
+#include <chrono>      // std::chrono::milliseconds
+#include <cstdint>     // uint8_t, uint32_t, uint64_t
+#include <thread>      // std::thread
+
+namespace cx
+{
+    /**
+     * @brief 트리플 버퍼 기반 렌더 스레드
+     *
+     * @details
+     *   버퍼 3개를 앱(그리는 중), 중간(최신 제출 프레임), Writer(출력 중)가 하나씩 나누어 가집니다.
+     *   Submit()과 Writer는 중간 버퍼와 자기 버퍼를 atomic exchange 한 번으로 맞바꾸므로 잠금이 없습니다.
+     *   - 앱은 Writer가 출력을 끝내기를 기다리지 않습니다.
+     *   - Writer가 가져가기 전에 새 프레임이 제출되면 이전 프레임은 출력되지 않고 버려집니다.
+     *     (터미널이 따라오지 못하면 중간 프레임을 건너뛰고 항상 최신 프레임을 출력)
+     *
+     * @note  GetBuffer()가 돌려주는 버퍼는 Submit()할 때마다 바뀌며, 몇 프레임 전 내용이 남아 있습니다.
+     *        매 프레임 Clear()부터 시작하여 화면 전체를 그려야 합니다.
+     * @note  Writer는 Screen::Write()의 출력 큐로 출력하므로, 앱 스레드의 Screen 함수와 Device 질의는 프레임과 섞이지 않습니다.
+     *        동작 중에는 앱 스레드에서 std::cout으로 직접 출력하지 않습니다.
+     *
+     * @code
+     *   cx::Renderer renderer;
+     *   while( running ) {
+     *       cx::Buffer& buffer = renderer.GetBuffer();
+     *       buffer.Resize( cols, rows );
+     *       buffer.Clear();
+     *       ... 그리기 ...
+     *       renderer.Submit();    // 바로 리턴, 출력은 Writer 스레드에서
+     *   }
+     * @endcode
+     */
+    class Renderer
+    {
+    public:
+        Renderer( void );
+        ~Renderer();
+
+        Renderer( const Renderer& ) = delete;
+        Renderer& operator=( const Renderer& ) = delete;
+
+        /// @brief 앱이 다음 프레임을 그릴 버퍼 (Submit() 후에는 다른 버퍼로 바뀜)
+        /// @note  이 버퍼에 설정한 출력 옵션(SetOutputBudget 등)은 Writer의 Flush()에 적용되고, 다음 버퍼로 이어집니다.
+        Buffer& GetBuffer( void ) { return slots_[app_index_]; }
+
+        /**
+         * @brief   그린 프레임을 Writer 스레드에 넘깁니다. (대기 없음)
+         * @details 새로 받는 버퍼는 제출한 프레임과 같은 크기로 맞춰집니다.
+         */
+        void Submit( void );
+
+        /// @brief Writer 스레드를 멈춥니다. (제출했지만 아직 출력하지 않은 프레임은 출력 후 종료)
+        /// @details 터미널에 다 쓰지 못한 출력은 SHUTDOWN_DRAIN_TIMEOUT까지 기다려 모두 쓰므로,
+        ///          리턴 후에는 std::cout으로 바로 출력해도 마지막 프레임과 섞이지 않습니다.
+        void Stop( void );
+
+        /// @brief 출력하기 전에 새 프레임으로 대체되어 버려진 프레임 수
+        uint64_t GetDroppedFrames( void ) const { return dropped_frames_.load( std::memory_order_relaxed ); }
+
+        /// @brief 터미널로 출력한 프레임 수
+        uint64_t GetWrittenFrames( void ) const { return written_frames_.load( std::memory_order_relaxed ); }
+
+        /// @brief 터미널 스크롤로 행을 옮긴 프레임 수 (GetBuffer()에 SetScrollDetection( true )를 설정한 경우)
+        uint64_t GetScrolledFrames( void ) const { return scrolled_frames_.load( std::memory_order_relaxed ); }
+
+        /// @brief Stop()에서 남은 출력을 기다리는 최대 시간
+        static constexpr std::chrono::milliseconds SHUTDOWN_DRAIN_TIMEOUT { 1000 };
+
+    private:
+        void WriterLoop( void );
+
+        static constexpr uint8_t INDEX_MASK = 0x03;
+        static constexpr uint8_t FRESH_BIT  = 0x04; // 중간 버퍼에 Writer가 아직 가져가지 않은 프레임이 있음
+
+        std::array<Buffer, 3> slots_;
+        uint8_t               app_index_    = 0;  // 앱 스레드 전용
+        uint8_t               writer_index_ = 1;  // Writer 스레드 전용
+        std::atomic<uint8_t>  middle_ { 2 };      // 중간 버퍼 번호 | FRESH_BIT
+
+        // Writer가 화면 상태(front)를 보관하고 Diff를 계산하는 버퍼
+        // (출력할 프레임의 back과 맞바꾼 뒤 Flush하므로 셀 복사가 없음)
+        Buffer screen_;
+
+        std::atomic<uint32_t> submit_seq_ { 0 };  // Submit()마다 증가 (Writer 깨우기, atomic wait)
+        std::atomic<bool>     stop_       { false };
+        std::atomic<uint64_t> dropped_frames_ { 0 };
+        std::atomic<uint64_t> written_frames_ { 0 };
+        std::atomic<uint64_t> scrolled_frames_ { 0 }; // Writer의 screen_ 값을 옮겨 둠 (앱 스레드에서 읽음)
+
+        std::thread writer_;
+    };
+
+} // namespace cx
+
+#endif // _CONSOLE_X_RENDERER_HPP_
@@ -10,6 +10,8 @@
  *  ------------------------------------------------------------------------------------ */
 
 #include <string>
+#include <string_view>
+#include <chrono>
 #include <iostream>
 
 #include "cx_color.hpp" // 색상 정의 사용
@@ -72,6 +74,8 @@ namespace cx
     /**
      * @brief 콘솔 화면 제어 정적 클래스
      * @details 커서 이동, 화면 지우기, 터미널 크기 조회 등 출력 관련 기능을 제공합니다.
+     *          라이브러리의 모든 터미널 출력(Buffer::Flush, Screen 함수, Device 질의/모드 전환)은
+     *          Write()의 출력 큐 하나를 거치므로, 서로의 이스케이프 시퀀스 중간에 끼어들지 않습니다.
      */
     class Screen
     {
@@ -129,6 +133,28 @@ namespace cx
          */
         static void ResetColor( void );
 
+        /**
+         * @brief 터미널로 출력합니다. (Non-Blocking, 여러 스레드에서 호출 가능)
+         *
+         * @details
+         *   터미널이 다 받지 못한 나머지는 출력 큐에 보관했다가 다음 Write()/FlushOutput()/DrainOutput()에서 이어서 씁니다.
+         *   큐에 남은 출력이 있으면 그 뒤에 붙이므로, 느린 터미널에서도 순서가 유지되고 시퀀스가 끊기지 않습니다.
+         *   std::cout으로 직접 출력할 때는 HasPendingOutput()이 false일 때만 (종료 전에는 DrainOutput() 먼저)
+         */
+        static void Write( std::string_view data );
+
+        /// @brief 출력 큐에 남은 출력을 대기 없이 이어서 씁니다. (모두 썼으면 true)
+        static bool FlushOutput( void );
+
+        /// @brief 아직 터미널에 쓰지 못한 출력이 있는지
+        static bool HasPendingOutput( void );
+
+        /// @brief 아직 터미널에 쓰지 못한 출력의 바이트 수
+        static size_t GetPendingOutput( void );
+
+        /// @brief 남은 출력을 터미널이 받을 수 있을 때마다 timeout까지 이어서 씁니다. (모두 썼으면 true)
+        static bool DrainOutput( std::chrono::milliseconds timeout );
+
     private:
         // Static Class: 인스턴스 생성 금지
         Screen()  = delete;
@@ -0,0 +1,334 @@
+#ifndef _CONSOLE_X_TASK_HPP_
+#define _CONSOLE_X_TASK_HPP_
+
+/** ------------------------------------------------------------------------------------
+ *  ConsoleX Coroutine Module
+ *  ------------------------------------------------------------------------------------
+ *  - Task<T>   : C++20 코루틴 반환 타입 (co_await로 다른 Task를 호출하고 결과를 받음)
+ *  - EventLoop : 한 스레드에서 여러 Task를 번갈아 실행하는 이벤트 루프
+ *                (NextEvent, Sleep, NextFrame, CursorPos를 co_await로 기다림)
+ *
+ *  마법사 화면, 확인 대화상자처럼 여러 단계의 입력을 받는 로직을 상태 머신이나
+ *  대화상자별 스레드 없이, 위에서 아래로 읽히는 순서대로 작성할 수 있습니다.
+ *  ------------------------------------------------------------------------------------ */
+
+#include "cx_device.hpp"
+
+#include <coroutine>   // std::coroutine_handle
+#include <exception>   // std::exception_ptr
+#include <optional>    // std::optional
+#include <utility>     // std::move, std::exchange
+#include <chrono>      // std::chrono::steady_clock
+#include <deque>       // std::deque
+#include <list>        // std::list
+#include <map>         // std::multimap
+#include <memory>      // std::shared_ptr
+#include <vector>      // std::vector
+#include <atomic>      // std::atomic
+#include <mutex>       // std::mutex
+#include <functional>  // std::function
+
+namespace cx
+{
+    class EventLoop;
+
+    template <typename T = void>
+    class Task;
+
+    /// @brief Task의 결과 보관 (void와 값 있는 Task의 차이만 분리)
+    template <typename T>
+    struct TaskResult
+    {
+        std::optional<T> value;
+
+        template <typename U>
+        void return_value( U&& v ) { value.emplace( std::forward<U>( v ) ); }
+
+        T Take( void ) { return std::move( *value ); }
+    };
+
+    template <>
+    struct TaskResult<void>
+    {
+        void return_void( void ) {}
+        void Take( void ) {}
+    };
+
+    // =========================================================================
+    // Task
+    // =========================================================================
+
+    /**
+     * @brief 코루틴 Task (Move Only, 소멸 시 코루틴 프레임 해제)
+     *
+     * @details
+     *   - 만들어진 직후에는 실행되지 않고, co_await 하거나 EventLoop::Spawn()에 넘기면 시작합니다.
+     *   - 끝나면 기다리던 코루틴을 바로 이어서 실행하므로 (Symmetric Transfer),
+     *     Task를 깊게 중첩해도 스택이 쌓이지 않습니다.
+     *   - 코루틴 안에서 발생한 예외는 co_await 한 쪽에서 다시 던져집니다.
+     *
+     * @code
+     *   cx::Task<bool> Confirm( cx::EventLoop& loop )
+     *   {
+     *       for( ;; ) {
+     *           auto event = co_await loop.NextEvent();
+     *           if( event.IsKey( cx::Key::y ) ) co_return true;
+     *           if( event.IsKey( cx::Key::n ) ) co_return false;
+     *       }
+     *   }
+     * @endcode
+     */
+    template <typename T>
+    class [[nodiscard]] Task
+    {
+    public:
+        struct promise_type;
+        using Handle = std::coroutine_handle<promise_type>;
+
+        /// @brief 끝난 뒤 기다리던 코루틴으로 바로 넘어감 (없으면 EventLoop로 돌아감)
+        struct FinalAwaiter
+        {
+            bool await_ready( void ) noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend( Handle handle ) noexcept
+            {
+                auto next = handle.promise().continuation;
+                return next ? next : std::noop_coroutine();
+            }
+
+            void await_resume( void ) noexcept {}
+        };
+
+        struct promise_type : TaskResult<T>
+        {
+            std::coroutine_handle<> continuation;
+            std::exception_ptr      exception;
+
+            Task get_return_object( void ) { return Task( Handle::from_promise( *this ) ); }
+
+            std::suspend_always initial_suspend( void ) noexcept { return {}; }
+            FinalAwaiter        final_suspend  ( void ) noexcept { return {}; }
+
+            void unhandled_exception( void ) { exception = std::current_exception(); }
+        };
+
+        Task( void ) = default;
+        ~Task() { if( handle_ ) handle_.destroy(); }
+
+        Task( Task&& other ) noexcept : handle_( std::exchange( other.handle_, nullptr ) ) {}
+        Task& operator=( Task&& other ) noexcept
+        {
+            if( this != &other ) {
+                if( handle_ ) handle_.destroy();
+                handle_ = std::exchange( other.handle_, nullptr );
+            }
+            return *this;
+        }
+
+        Task( const Task& ) = delete;
+        Task& operator=( const Task& ) = delete;
+
+        bool IsValid( void ) const { return static_cast<bool>( handle_ ); }
+        bool IsDone ( void ) const { return !handle_ || handle_.done(); }
+
+        auto operator co_await() const noexcept
+        {
+            struct Awaiter
+            {
+                Handle handle;
+
+                bool await_ready( void ) noexcept { return !handle || handle.done(); }
+
+                std::coroutine_handle<> await_suspend( std::coroutine_handle<> caller ) noexcept
+                {
+                    handle.promise().continuation = caller;
+                    return handle;
+                }
+
+                T await_resume( void )
+                {
+                    if( handle.promise().exception ) std::rethrow_exception( handle.promise().exception );
+                    return handle.promise().Take();
+                }
+            };
+            return Awaiter{ handle_ };
+        }
+
+    private:
+        friend class EventLoop;
+        explicit Task( Handle handle ) : handle_( handle ) {}
+
+        Handle handle_ = nullptr;
+    };
+
+    // =========================================================================
+    // EventLoop
+    // =========================================================================
+
+    /**
+     * @brief 단일 스레드 코루틴 이벤트 루프
+     *
+     * @details
+     *   Device를 구독(이벤트 루프용 이벤트 포함)하여 이벤트를 받고, 기다리던 코루틴을 이어서 실행합니다.
+     *   모든 코루틴은 Run()을 호출한 스레드에서만 실행되므로, 코루틴끼리는 잠금 없이 상태를 공유할 수 있습니다.
+     *
+     *   - NextEvent() : 다음 입력 이벤트 (기다리는 코루틴이 여럿이면 모두 같은 이벤트를 받음)
+     *                   기다리는 코루틴이 없을 때 들어온 이벤트는 보관했다가 다음 NextEvent()에 전달
+     *   - Sleep()     : 지정한 시간 동안 대기 (다른 코루틴은 계속 실행됨)
+     *   - NextFrame() : 렌더링 시점(FRAME_EVENT) 대기 (RequestFrame()을 대신 호출)
+     *   - CursorPos() : 커서 위치 질의 응답 대기 (Device::Query, 응답 대기 중에도 입력은 계속 처리됨)
+     *
+     * @code
+     *   cx::EventLoop loop;
+     *   loop.Spawn( Wizard( loop ) );  // Wizard()는 cx::Task<> 코루틴
+     *   loop.Run();                    // 모든 Task가 끝나거나 Stop()이 호출되면 리턴
+     * @endcode
+     */
+    class EventLoop
+    {
+    public:
+        using Clock     = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+
+        explicit EventLoop( size_t capacity = Device::DEFAULT_QUEUE_CAPACITY );
+        ~EventLoop();
+
+        EventLoop( const EventLoop& ) = delete;
+        EventLoop& operator=( const EventLoop& ) = delete;
+
+        /// @brief Task를 루프에 등록합니다. (다음 Run() 순회에서 시작, 코루틴 안에서 호출해도 됨)
+        void Spawn( Task<> task );
+
+        /**
+         * @brief   등록된 Task가 모두 끝날 때까지 이벤트를 처리합니다.
+         * @details Task에서 처리되지 않은 예외가 발생하면 그 Task를 정리한 뒤 여기서 다시 던집니다.
+         */
+        void Run( void );
+
+        /// @brief [Thread-Safe] Run()을 멈춥니다. (끝나지 않은 Task는 보존되어, 다시 Run() 하면 이어서 실행)
+        void Stop( void );
+
+        /// @brief [Thread-Safe] fn을 루프 스레드에서 실행합니다. (워커 스레드의 결과를 코루틴 쪽으로 넘길 때)
+        void Post( std::function<void()> fn );
+
+        // --- Awaitables (이 루프에서 실행 중인 코루틴 안에서만 co_await) -----
+
+        /// @brief 대기 중인 코루틴 하나 (NextEvent, NextFrame, Sleep 공통)
+        struct Waiter
+        {
+            EventLoop&              loop;
+            std::coroutine_handle<> handle   = nullptr;
+            Device::Event           event    = {};
+            bool                    received = false; // 이벤트를 받았는지 (false: 시간 초과)
+            bool                    waiting_event = false; // event_waiters_에 등록됨
+            bool                    has_timer     = false; // timers_에 등록됨
+
+            std::list<Waiter*>::iterator                event_it {}; // 유효 조건: waiting_event
+            std::multimap<TimePoint, Waiter*>::iterator timer_it {}; // 유효 조건: has_timer
+        };
+
+        /// @brief co_await loop.NextEvent() -> Device::Event
+        struct EventAwaiter : Waiter
+        {
+            bool          await_ready  ( void );
+            void          await_suspend( std::coroutine_handle<> handle );
+            Device::Event await_resume ( void ) { return std::move( this->event ); }
+        };
+
+        /// @brief co_await loop.NextEvent( timeout ) -> std::optional<Device::Event> (시간 초과 시 nullopt)
+        struct TimedEventAwaiter : Waiter
+        {
+            TimePoint deadline;
+
+            bool await_ready  ( void );
+            void await_suspend( std::coroutine_handle<> handle );
+            std::optional<Device::Event> await_resume( void )
+            {
+                if( !this->received ) return std::nullopt;
+                return std::move( this->event );
+            }
+        };
+
+        /// @brief co_await loop.Sleep( duration )
+        struct SleepAwaiter : Waiter
+        {
+            TimePoint deadline;
+
+            bool await_ready  ( void ) { return deadline <= Clock::now(); }
+            void await_suspend( std::coroutine_handle<> handle );
+            void await_resume ( void ) {}
+        };
+
+        /// @brief co_await loop.NextFrame() -> Device::Event (FRAME_EVENT)
+        struct FrameAwaiter : Waiter
+        {
+            bool          await_ready  ( void ) { return false; }
+            void          await_suspend( std::coroutine_handle<> handle );
+            Device::Event await_resume ( void ) { return std::move( this->event ); }
+        };
+
+        /// @brief co_await loop.CursorPos() -> std::optional<Coord> (응답이 없으면 nullopt)
+        struct CursorAwaiter
+        {
+            EventLoop&                loop;
+            std::chrono::milliseconds timeout;
+            std::optional<Coord>      result;
+
+            bool                 await_ready  ( void ) { return false; }
+            void                 await_suspend( std::coroutine_handle<> handle );
+            std::optional<Coord> await_resume ( void ) { return result; }
+        };
+
+        EventAwaiter NextEvent( void ) { return EventAwaiter{ { *this } }; }
+
+        template <typename Rep, typename Period>
+        TimedEventAwaiter NextEvent( const std::chrono::duration<Rep, Period>& timeout )
+        {
+            return TimedEventAwaiter{ { *this }, Clock::now() + std::chrono::duration_cast<Clock::duration>( timeout ) };
+        }
+
+        template <typename Rep, typename Period>
+        SleepAwaiter Sleep( const std::chrono::duration<Rep, Period>& duration )
+        {
+            return SleepAwaiter{ { *this }, Clock::now() + std::chrono::duration_cast<Clock::duration>( duration ) };
+        }
+
+        FrameAwaiter NextFrame( void ) { return FrameAwaiter{ { *this } }; }
+
+        CursorAwaiter CursorPos( std::chrono::milliseconds timeout = Device::DEFAULT_QUERY_TIMEOUT )
+        {
+            return CursorAwaiter{ *this, timeout, std::nullopt };
+        }
+
+    private:
+        void Dispatch  ( Device::Event&& event );
+        void RunReady  ( void );
+        void RunPosted ( void );
+        void FireTimers( TimePoint now );
+        void AddTimer  ( Waiter& waiter, TimePoint deadline );
+
+        /// @brief Query callback(Reader 스레드)과 공유하는 부분 (루프가 먼저 사라져도 안전하도록 shared_ptr)
+        struct Shared
+        {
+            Device::Subscription               sub;
+            std::mutex                         mtx;
+            std::vector<std::function<void()>> posted;
+
+            void Post( std::function<void()> fn );
+        };
+
+        std::shared_ptr<Shared>           shared_;
+        size_t                            capacity_;
+        std::atomic<bool>                 stop_ { false };
+
+        std::list<Task<>>                 roots_;          // Spawn()으로 등록된 Task
+        std::deque<std::coroutine_handle<>> ready_;        // 이어서 실행할 코루틴
+        std::deque<Device::Event>         pending_events_; // 기다리는 코루틴이 없을 때 들어온 이벤트
+        std::list<Waiter*>                event_waiters_;
+        std::vector<Waiter*>              frame_waiters_;
+        std::multimap<TimePoint, Waiter*> timers_;
+    };
+
+} // namespace cx
+
+#endif // _CONSOLE_X_TASK_HPP_
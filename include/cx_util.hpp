@@ -5,15 +5,184 @@
  *  ConsoleX String Utility Module
  *  ------------------------------------------------------------------------------------
  *  UTF-8 문자열의 너비 계산, 문자열 분할, ANSI 코드 제거 등의
- *  helper 기능을 제공하는 정적 클래스입니다.
+ *  helper 기능을 제공하는 정적 클래스와 ANSI/VT 시퀀스 토크나이저입니다.
  *  ------------------------------------------------------------------------------------ */
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstdint>
 
 namespace cx
 {
+    // =========================================================================
+    // Line Breaking Structures
+    // =========================================================================
+
+    /**
+     * @brief 줄바꿈 위치 결정 방식
+     */
+    enum class WrapMode
+    {
+        GREEDY,     // 한 줄에 최대한 채움 (선형 시간)
+        MIN_RAGGED  // 줄 끝 여백의 제곱합을 최소화 (문단 단위 동적 계획법)
+    };
+
+    /**
+     * @brief UAX #14 기반의 단순화된 줄바꿈 분류 (Line Break Class)
+     */
+    enum class BreakClass : uint8_t
+    {
+        AL,   // 일반 문자 (영문, 숫자 등) - 서로 붙어 있으면 단어로 취급
+        SP,   // 공백 (Space, Tab) - 뒤쪽에서 줄바꿈 가능, 줄 끝에서는 너비 무시
+        BK,   // 강제 줄바꿈 (\n)
+        BA,   // 뒤쪽에서 줄바꿈 가능 (하이픈 등)
+        ID,   // 표의 문자 (한글, 한자, 전각, 이모지) - 앞뒤 모두 줄바꿈 가능
+        OP,   // 여는 괄호 - 뒤쪽 줄바꿈 금지
+        CL,   // 닫는 괄호, 구두점 - 앞쪽 줄바꿈 금지
+        GL,   // No-Break Space - 앞뒤 모두 줄바꿈 금지
+        ANSI  // ANSI Escape Code - 너비 0, 줄바꿈 판단에서 투명하게 취급
+    };
+
+    /**
+     * @brief 화면상 한 글자(클러스터)의 정보
+     *
+     * @details
+     *   결합 문자(Combining, ZWJ, Variation Selector 등)는 앞 글자에 합쳐져
+     *   하나의 클러스터가 됩니다. 줄바꿈 엔진은 원본 문자열 대신
+     *   이 배열만 보고 동작하므로, 한 번 계산해두면 너비를 바꿔가며
+     *   여러 번 줄바꿈해도 UTF-8 디코딩을 반복하지 않습니다.
+     */
+    struct TextCluster
+    {
+        uint32_t   offset      = 0;              // 원본 문자열 내 바이트 오프셋
+        uint32_t   bytes       = 0;              // 클러스터의 바이트 길이
+        uint16_t   width       = 0;              // 표시 너비 (0, 1, 2 ...)
+        BreakClass cls         = BreakClass::AL; // 줄바꿈 분류
+        bool       break_before = false;         // 이 클러스터 앞에서 줄바꿈 가능 여부
+    };
+
+    /**
+     * @brief 줄바꿈 결과 한 줄 ( 클러스터 인덱스 [first, last) )
+     * @note  줄 끝의 공백 클러스터는 범위와 너비에서 제외됩니다.
+     */
+    struct TextLine
+    {
+        uint32_t first = 0; // 첫 클러스터 인덱스
+        uint32_t last  = 0; // 마지막 클러스터 다음 인덱스
+        uint32_t width = 0; // 표시 너비
+    };
+
+    // =========================================================================
+    // ANSI / VT Escape Sequence Tokenizer
+    // =========================================================================
+
+    /**
+     * @brief ANSI/VT 이스케이프 시퀀스 토크나이저 (Paul Williams VT Parser 기반)
+     *
+     * @details
+     *   입력 바이트를 한 번만 훑으면서 텍스트 런(Text Run)과 제어 토큰
+     *   (C0 제어 문자, ESC, CSI, OSC, DCS)을 순서대로 돌려줍니다.
+     *   상태가 객체에 유지되므로 Feed()로 입력을 나누어 넣어도
+     *   시퀀스가 중간에서 끊긴 부분부터 이어서 파싱합니다. (pty 출력 등)
+     *
+     *   - CSI 파라미터의 ':' (SGR 38:2::R:G:B 등)는 하위 파라미터로 기록합니다.
+     *   - OSC는 BEL 또는 ST(ESC \)로 끝나며, SOS/PM/APC 문자열은 버립니다.
+     *   - UTF-8 입력을 전제로 하므로 8-bit C1 제어 문자(0x80~0x9F)는 해석하지 않습니다.
+     */
+    class AnsiTokenizer
+    {
+    public:
+        enum class TokenType
+        {
+            TEXT,    // 출력 가능한 문자열 런 (UTF-8 그대로)
+            CONTROL, // C0 제어 문자 한 바이트 (\n, \r, \t, BEL ...)
+            ESC,     // ESC Dispatch (예: ESC 7, ESC ( B)
+            CSI,     // Control Sequence (예: ESC [ 1 ; 31 m)
+            OSC,     // Operating System Command (예: ESC ] 0 ; title BEL)
+            DCS      // Device Control String (예: ESC P ... ESC \)
+        };
+
+        static constexpr size_t MAX_PARAMS = 16;   // CSI/DCS 파라미터 최대 개수
+        static constexpr size_t MAX_STRING = 4096; // OSC/DCS 문자열 최대 길이 (초과분은 버림)
+
+        struct Token
+        {
+            TokenType        type = TokenType::TEXT;
+
+            // TEXT: 텍스트 런, 그 외: 시퀀스 원본 바이트
+            // (시퀀스가 이전 Feed()에서 시작되었다면 현재 입력에 포함된 부분만 가리킴)
+            std::string_view raw;
+
+            // OSC/DCS 문자열 데이터 (다음 Next() 호출 전까지만 유효)
+            std::string_view payload;
+
+            char     final_ch        = 0;       // CSI/ESC/DCS 종료 문자, CONTROL은 제어 문자 자체
+            char     prefix          = 0;       // Private Marker ('?', '<', '>', '=')
+            char     intermediate[2] = { 0, 0 };
+            uint8_t  param_count     = 0;
+            uint16_t sub_mask        = 0;       // i번째 비트: params[i]가 ':' 뒤의 하위 파라미터
+            int      params[MAX_PARAMS] = {};   // 생략된 파라미터는 -1
+
+            /// @brief idx번째 파라미터 (없거나 생략되었으면 def)
+            int Param( size_t idx, int def = 0 ) const
+            {
+                return ( idx < param_count && params[idx] >= 0 ) ? params[idx] : def;
+            }
+
+            /// @brief idx번째 파라미터가 ':'로 구분된 하위 파라미터인지 확인
+            bool IsSubParam( size_t idx ) const { return idx < MAX_PARAMS && ( sub_mask >> idx ) & 1; }
+        };
+
+    public:
+        AnsiTokenizer() = default;
+        explicit AnsiTokenizer( std::string_view input ) { Feed( input ); }
+
+        /**
+         * @brief 다음 입력 조각을 설정합니다. 파서 상태(진행 중인 시퀀스)는 유지됩니다.
+         * @note  input은 Next()가 false를 반환할 때까지 유효해야 합니다.
+         */
+        void Feed( std::string_view input );
+
+        /**
+         * @brief  다음 토큰을 꺼냅니다.
+         * @return 토큰이 있으면 true, 현재 입력을 모두 소비했으면 false
+         */
+        bool Next( Token& token );
+
+        /// @brief 파서 상태를 초기화합니다. (진행 중인 시퀀스 폐기)
+        void Reset( void );
+
+        /// @brief 시퀀스 밖(Ground 상태)인지 확인
+        bool IsGround( void ) const { return state_ == State::GROUND; }
+
+    private:
+        enum class State : uint8_t
+        {
+            GROUND,
+            ESCAPE, ESCAPE_INTERMEDIATE,
+            CSI_ENTRY, CSI_PARAM, CSI_INTERMEDIATE, CSI_IGNORE,
+            DCS_ENTRY, DCS_PARAM, DCS_INTERMEDIATE, DCS_PASSTHROUGH, DCS_IGNORE,
+            OSC_STRING, SOS_PM_APC_STRING
+        };
+
+        void Clear( void );
+        void Collect( char c );
+        void AddParam( char c );
+        void Put( char c );
+        bool Emit( Token& token, TokenType type, char final_ch, size_t end );
+
+        std::string_view input_;
+        size_t           pos_       = 0;
+        size_t           seq_start_ = 0;     // 현재 시퀀스의 시작 위치 (input_ 기준)
+        State            state_     = State::GROUND;
+        bool             st_pending_ = false; // 문자열 종료 ESC 직후 ('\' 대기)
+
+        // 진행 중인 시퀀스 정보
+        Token            seq_ {};
+        std::string      str_buf_;
+    };
+
     /**
      * @brief 문자열 처리 유틸리티 클래스
      */
@@ -31,18 +200,66 @@ namespace cx
          * @brief  문자열을 지정된 너비(max_width)에 맞춰 여러 줄로 분할합니다.
          * @param  str 원본 문자열
          * @param  max_width 한 줄당 최대 허용 너비
+         * @param  mode 줄바꿈 방식 (기본: GREEDY)
          * @return 분할된 문자열 리스트
          *
          * @details
-         *   단어 중간에서 잘리지 않도록 멀티바이트 문자를 고려하여 자릅니다.
+         *   공백, 하이픈, 한글/한자 경계 등 줄바꿈 가능 위치에서만 자르며,
+         *   한 줄보다 긴 단어만 예외적으로 글자 단위로 자릅니다.
+         *   '\n'은 강제 줄바꿈으로 처리되고, 줄 끝 공백은 제거됩니다.
          */
-        static std::vector<std::string> SplitStringByWidth( const std::string& str, size_t max_width );
+        static std::vector<std::string> SplitStringByWidth( const std::string& str, size_t max_width,
+                                                            WrapMode mode = WrapMode::GREEDY );
+
+        /**
+         * @brief 문자열을 클러스터 단위로 분석하여 너비와 줄바꿈 분류를 계산합니다.
+         * @param str 원본 문자열 (UTF-8, ANSI 코드 포함 가능)
+         * @param out 결과 배열 (기존 내용은 지워지며, 할당된 용량은 재사용)
+         */
+        static void BuildClusters( std::string_view str, std::vector<TextCluster>& out );
+
+        /**
+         * @brief 미리 계산된 클러스터 배열을 max_width에 맞춰 줄 단위로 나눕니다.
+         * @param clusters  BuildClusters()의 결과
+         * @param max_width 한 줄당 최대 허용 너비
+         * @param out       결과 줄 목록 (기존 내용은 지워지며, 할당된 용량은 재사용)
+         * @param mode      줄바꿈 방식
+         *
+         * @details
+         *   GREEDY는 클러스터 수에 비례하는 선형 시간으로 동작합니다.
+         *   MIN_RAGGED는 문단마다 줄 끝 여백의 제곱합을 최소화하며,
+         *   한 줄에 들어가는 후보만 검사하므로 O(n * max_width)입니다.
+         *   두 방식 모두 출력 벡터 외에는 호출마다 메모리를 새로 할당하지 않습니다.
+         */
+        static void BreakLines( const std::vector<TextCluster>& clusters, size_t max_width,
+                                std::vector<TextLine>& out, WrapMode mode = WrapMode::GREEDY );
 
         /**
          * @brief 문자열에서 ANSI Escape Code(색상 등)를 제거한 순수 문자열을 반환합니다.
          */
         static std::string StripAnsiCodes( const std::string& str );
 
+        /**
+         * @brief  UTF-8 문자 하나를 디코딩합니다.
+         * @param  str       문자 시작 위치
+         * @param  avail     str부터 읽을 수 있는 바이트 수
+         * @param  codepoint [out] 코드포인트 (잘못된 시퀀스는 0)
+         * @return 문자의 바이트 길이 (최소 1)
+         */
+        static int DecodeUtf8( const char* str, size_t avail, uint32_t& codepoint );
+
+        /// @brief UTF-8 선행 바이트로부터 문자의 바이트 길이를 구합니다. (ASCII나 잘못된 바이트는 1)
+        static size_t GetUtf8SeqLength( unsigned char lead );
+
+        /// @brief 코드포인트 하나를 UTF-8로 인코딩하여 out 뒤에 붙입니다. (범위 밖은 U+FFFD)
+        static void AppendUtf8( std::string& out, uint32_t codepoint );
+
+        /**
+         * @brief 코드포인트 하나의 콘솔 출력 너비를 반환합니다. (결합 문자=0, 한글=2, 영문=1)
+         * @param codepoint 유니코드 코드포인트
+         */
+        static int GetCharWidth( uint32_t codepoint );
+
         /**
          * @brief 해당 UTF-8 문자가 2칸(Double Width)을 차지하는지 확인합니다.
          * @param codepoint 유니코드 코드포인트
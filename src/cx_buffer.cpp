@@ -1,11 +1,59 @@
 #include "cx_buffer.hpp"
+#include "cx_caps.hpp"
+#include "cx_screen.hpp"
 #include "cx_util.hpp"
 
 #include <iostream>
 #include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h> // SSE2, AVX2 (AVX2 함수는 target 속성으로만 컴파일하고 실행 시 CPU 확인 후 사용)
+#endif
 
 namespace cx {
 
+    // =========================================================================
+    // 행 해시
+    // =========================================================================
+    // 행 해시 = 각 셀의 (바이트, x 좌표) 해시의 합 (mod 2^64)
+    // - 합이므로 셀 하나를 고칠 때 옛 값을 빼고 새 값을 더하는 것만으로 갱신됨 (행 전체 재계산 없음)
+    // - x 좌표를 섞으므로 행 안에서 셀 순서가 바뀌어도 달라지고, y는 섞지 않으므로 다른 행으로 옮겨진 행도 찾을 수 있음
+
+    // 두 값을 곱한 128비트 결과의 상위/하위를 섞음 (곱셈 두 번이 서로 독립이라 셀 하나에 몇 사이클)
+    static inline uint64_t MulFold(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+        __uint128_t r = static_cast<__uint128_t>(a) * b;
+        return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+        uint64_t h = (a ^ (b >> 29)) * 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 32;
+        return (h ^ b) * 0x94D049BB133111EBULL;
+#endif
+    }
+
+    static inline uint64_t CellHash(const Cell& cell, int x) {
+        uint64_t w[sizeof(Cell) / sizeof(uint64_t)];
+        std::memcpy(w, &cell, sizeof(Cell));
+
+        uint64_t k = static_cast<uint64_t>(x + 1) * 0x9E3779B97F4A7C15ULL;
+        return MulFold(w[0] ^ k ^ 0xA0761D6478BD642FULL, w[1] ^ 0xE7037ED1A0B428DBULL) +
+               MulFold(w[2] ^ 0x8EBC6AF09C88C6E3ULL, w[3] ^ k ^ 0x589965CC75374CC3ULL);
+    }
+
+    static uint64_t RowHash(const std::vector<Cell>& row) {
+        uint64_t h = 0;
+        for (int x = 0; x < static_cast<int>(row.size()); ++x) h += CellHash(row[x], x);
+        return h;
+    }
+
     void Buffer::Resize(int w, int h) {
         if (width_ == w && height_ == h) return;
         width_ = w;
@@ -14,64 +62,267 @@ namespace cx {
         // Front/Back 버퍼 메모리 할당
         front_buffer_.assign(h, std::vector<Cell>(w));
         back_buffer_.assign(h, std::vector<Cell>(w));
+        front_hash_.assign(h, 0);
+        back_hash_.assign(h, h > 0 ? RowHash(back_buffer_[0]) : 0);
 
         // 리사이즈 직후에는 화면 전체 갱신을 위해 Front를 초기화
-        ClearImpl(front_buffer_, Color::Black);
+        ClearImpl(front_buffer_, front_hash_, Color::Black);
     }
 
     void Buffer::Clear(const Color& bg_color) {
-        ClearImpl(back_buffer_, bg_color);
+        ClearImpl(back_buffer_, back_hash_, bg_color);
     }
 
-    void Buffer::ClearImpl(std::vector<std::vector<Cell>>& buf, const Color& bg) {
+    void Buffer::ClearImpl(std::vector<std::vector<Cell>>& buf, std::vector<uint64_t>& hashes, const Color& bg) {
         for(auto& row : buf) {
             for(auto& cell : row) {
                 cell.ch = " ";
                 cell.fg = Color::White;
                 cell.bg = bg;
+                cell.attr = ATTR_NONE;
                 cell.is_wide_trail = false;
+                cell.width = 1;
             }
         }
+
+        // 모든 행이 같으므로 해시는 한 번만 계산
+        if (!buf.empty()) std::fill(hashes.begin(), hashes.end(), RowHash(buf[0]));
     }
 
     void Buffer::DrawString(int x, int y, const std::string& text, const Color& fg, const Color& bg) {
         if (y < 0 || y >= height_) return;
 
         int cursor_x = x;
+        DrawRun(cursor_x, y, text, TextStyle{ fg, bg, ATTR_NONE });
+    }
+
+    void Buffer::DrawRun(int& cursor_x, int y, std::string_view run, const TextStyle& style) {
         size_t i = 0;
-        size_t len = text.length();
+        size_t len = run.length();
+
+        // 행 해시 갱신: 처음 고치는 셀의 옛 해시를 빼 두고, 고친 구간 [touched_lo, touched_hi]의 새 해시는 나중에 한 번에 더함
+        // (방금 바이트 단위로 쓴 셀을 바로 8바이트씩 읽으면 Store Forwarding이 실패하여 셀마다 수십 사이클 지연)
+        uint64_t row_hash = back_hash_[y];
+        int touched_lo = -1, touched_hi = -1;
+        auto add_touched = [&]() {
+            for (int tx = touched_lo; tx >= 0 && tx <= touched_hi; ++tx) row_hash += CellHash(back_buffer_[y][tx], tx);
+        };
+        auto touch = [&](int tx) {
+            if (touched_lo >= 0 && tx >= touched_lo && tx <= touched_hi) return; // 이미 뺌
+            if (touched_lo < 0 || tx != touched_hi + 1) {                        // 이어지지 않는 셀: 새 구간 시작
+                add_touched();
+                touched_lo = tx;
+            }
+            touched_hi = tx;
+            row_hash -= CellHash(back_buffer_[y][tx], tx);
+        };
 
         while (i < len && cursor_x < width_) {
-            // UTF-8 문자 길이 계산
-            int char_len = 1;
-            unsigned char c = (unsigned char)text[i];
-            if      (c < 0x80) char_len = 1;
-            else if ((c & 0xE0) == 0xC0) char_len = 2;
-            else if ((c & 0xF0) == 0xE0) char_len = 3;
-            else if ((c & 0xF8) == 0xF0) char_len = 4;
+            // UTF-8 문자 길이 및 너비 계산 (임시 문자열 없이)
+            uint32_t codepoint = 0;
+            int char_len = Util::DecodeUtf8(run.data() + i, len - i, codepoint);
+            int visual_width = Util::GetCharWidth(codepoint);
 
-            std::string ch = text.substr(i, char_len);
-            int visual_width = (int)cx::Util::GetStringWidth(ch);
+            // 결합 문자(Zero Width)는 앞 칸의 문자에 덧붙임
+            if (visual_width == 0) {
+                int prev_x = cursor_x - 1;
+                if (prev_x >= 0 && prev_x < width_ && back_buffer_[y][prev_x].is_wide_trail) prev_x--;
+                if (prev_x >= 0 && prev_x < width_) {
+                    touch(prev_x);
+                    back_buffer_[y][prev_x].ch.append(run.data() + i, char_len);
+                }
+                i += char_len;
+                continue;
+            }
 
             if (cursor_x >= 0 && cursor_x < width_) {
                 auto& cell = back_buffer_[y][cursor_x];
-                cell.ch = ch;
-                cell.fg = fg;
-                cell.bg = bg;
+                touch(cursor_x);
+                cell.ch.assign(run.data() + i, char_len);
+                cell.fg = style.fg;
+                cell.bg = style.bg;
+                cell.attr = style.attr;
                 cell.is_wide_trail = false;
+                cell.width = static_cast<uint8_t>(visual_width);
 
                 // 2칸 문자(한글 등) 처리: 뒤쪽 칸은 Trail로 마킹
                 if (visual_width == 2 && cursor_x + 1 < width_) {
                     auto& trail = back_buffer_[y][cursor_x + 1];
-                    trail.ch = ""; // 렌더링 생략
-                    trail.fg = fg;
-                    trail.bg = bg;
+                    touch(cursor_x + 1);
+                    trail.ch.clear(); // 렌더링 생략
+                    trail.fg = style.fg;
+                    trail.bg = style.bg;
+                    trail.attr = style.attr;
                     trail.is_wide_trail = true;
+                    trail.width = 0;
                 }
             }
             cursor_x += visual_width;
             i += char_len;
         }
+
+        add_touched();
+        back_hash_[y] = row_hash;
+    }
+
+    void Buffer::DrawAnsi(int x, int y, std::string_view text, const Color& fg, const Color& bg) {
+        const TextStyle base{ fg, bg, ATTR_NONE };
+        TextStyle style = base;
+
+        int cursor_x = x;
+        int cursor_y = y;
+
+        AnsiTokenizer tokenizer(text);
+        AnsiTokenizer::Token token;
+
+        while (tokenizer.Next(token)) {
+            switch (token.type) {
+                case AnsiTokenizer::TokenType::TEXT:
+                    if (cursor_y >= 0 && cursor_y < height_) {
+                        DrawRun(cursor_x, cursor_y, token.raw, style);
+                    }
+                    break;
+
+                case AnsiTokenizer::TokenType::CONTROL:
+                    switch (token.final_ch) {
+                        case '\n': cursor_y++; cursor_x = x; break;
+                        case '\r': cursor_x = x; break;
+                        case '\b': if (cursor_x > x) cursor_x--; break;
+                        case '\t': {
+                            // 다음 탭 위치(8칸 단위)까지 배경색으로 채움
+                            int next = x + ((cursor_x - x) / 8 + 1) * 8;
+                            while (cursor_x < next) {
+                                if (cursor_y >= 0 && cursor_y < height_) DrawRun(cursor_x, cursor_y, " ", style);
+                                else cursor_x++;
+                                if (cursor_x >= width_) break;
+                            }
+                            break;
+                        }
+                        default: break;
+                    }
+                    break;
+
+                case AnsiTokenizer::TokenType::CSI:
+                    // SGR만 해석 (커서 이동, 화면 지우기 등은 무시)
+                    if (token.final_ch == 'm' && token.prefix == 0 && token.intermediate[0] == 0) {
+                        ApplySgr(token, style, base);
+                    }
+                    break;
+
+                default:
+                    // ESC, OSC, DCS는 무시
+                    break;
+            }
+
+            // 화면 아래로 벗어나면 더 그릴 필요 없음
+            if (cursor_y >= height_) break;
+        }
+    }
+
+    /**
+     * @brief SGR 38/48 확장 색상 파라미터를 해석합니다.
+     * @param i [in/out] 38 또는 48의 인덱스 -> 마지막으로 사용한 파라미터 인덱스
+     * @return 해석한 색상 (형식이 잘못되었으면 Type::NONE)
+     *
+     * @details
+     *   38;5;N / 38;2;R;G;B (세미콜론 형식)
+     *   38:5:N / 38:2:CS:R:G:B / 38:2:R:G:B (콜론 하위 파라미터 형식)
+     */
+    static Color ParseExtendedColor(const AnsiTokenizer::Token& token, size_t& i) {
+        size_t count = token.param_count;
+        if (i + 1 >= count) return Color();
+
+        int mode = token.Param(i + 1);
+
+        // 콜론 형식이면 이어지는 하위 파라미터 개수를 셈
+        size_t sub_count = 0;
+        if (token.IsSubParam(i + 1)) {
+            size_t j = i + 2;
+            while (j < count && token.IsSubParam(j)) j++;
+            sub_count = j - (i + 2);
+        }
+
+        if (mode == 5) {
+            if (i + 2 >= count) { i = count - 1; return Color(); }
+            Color c = Color::FromAnsi256(static_cast<uint8_t>(token.Param(i + 2) & 0xFF));
+            i += 2;
+            return c;
+        }
+
+        if (mode == 2) {
+            // 콜론 형식에서 Color Space ID가 포함된 경우 건너뜀
+            size_t first = (sub_count >= 4) ? i + 3 : i + 2;
+            if (first + 2 >= count) { i = count - 1; return Color(); }
+
+            auto Channel = [&](size_t idx) { return static_cast<uint8_t>(std::min(token.Param(idx), 255)); };
+            Color c(Channel(first), Channel(first + 1), Channel(first + 2));
+            i = first + 2;
+            return c;
+        }
+
+        i += 1 + sub_count;
+        return Color();
+    }
+
+    void Buffer::ApplySgr(const AnsiTokenizer::Token& token, TextStyle& style, const TextStyle& base) {
+        // 파라미터가 없으면 SGR 0과 동일
+        if (token.param_count == 0) {
+            style = base;
+            return;
+        }
+
+        for (size_t i = 0; i < token.param_count; ++i) {
+            // 하위 파라미터는 앞의 파라미터와 함께 처리됨 (예: 4:3)
+            if (token.IsSubParam(i)) continue;
+
+            int p = token.Param(i);
+            switch (p) {
+                case 0:  style = base; break;
+                case 1:  style.attr |= ATTR_BOLD; break;
+                case 2:  style.attr |= ATTR_DIM; break;
+                case 3:  style.attr |= ATTR_ITALIC; break;
+                case 4:
+                    // 4:0 은 밑줄 해제, 4:1~5 는 밑줄 스타일 (모두 밑줄로 취급)
+                    if (token.IsSubParam(i + 1) && token.Param(i + 1) == 0) style.attr &= ~ATTR_UNDERLINE;
+                    else style.attr |= ATTR_UNDERLINE;
+                    break;
+                case 5: case 6: style.attr |= ATTR_BLINK; break;
+                case 7:  style.attr |= ATTR_REVERSE; break;
+                case 8:  style.attr |= ATTR_HIDDEN; break;
+                case 9:  style.attr |= ATTR_STRIKE; break;
+                case 21: style.attr |= ATTR_UNDERLINE; break;
+                case 22: style.attr &= ~(ATTR_BOLD | ATTR_DIM); break;
+                case 23: style.attr &= ~ATTR_ITALIC; break;
+                case 24: style.attr &= ~ATTR_UNDERLINE; break;
+                case 25: style.attr &= ~ATTR_BLINK; break;
+                case 27: style.attr &= ~ATTR_REVERSE; break;
+                case 28: style.attr &= ~ATTR_HIDDEN; break;
+                case 29: style.attr &= ~ATTR_STRIKE; break;
+                case 39: style.fg = base.fg; break;
+                case 49: style.bg = base.bg; break;
+
+                case 38:
+                case 48: {
+                    Color c = ParseExtendedColor(token, i);
+                    if (c.IsValid()) (p == 38 ? style.fg : style.bg) = c;
+                    break;
+                }
+
+                default:
+                    if      (p >= 30  && p <= 37)  style.fg = Color::FromAnsi256(static_cast<uint8_t>(p - 30));
+                    else if (p >= 40  && p <= 47)  style.bg = Color::FromAnsi256(static_cast<uint8_t>(p - 40));
+                    else if (p >= 90  && p <= 97)  style.fg = Color::FromAnsi256(static_cast<uint8_t>(p - 90 + 8));
+                    else if (p >= 100 && p <= 107) style.bg = Color::FromAnsi256(static_cast<uint8_t>(p - 100 + 8));
+                    break;
+            }
+        }
+    }
+
+    void Buffer::SetCell(int x, int y, const Cell& cell) {
+        if (x < 0 || x >= width_ || y < 0 || y >= height_) return;
+        back_hash_[y] -= CellHash(back_buffer_[y][x], x);
+        back_buffer_[y][x] = cell;
+        back_hash_[y] += CellHash(back_buffer_[y][x], x);
     }
 
     void Buffer::DrawBox(int x, int y, int w, int h, const Color& fg, const Color& bg, bool red_border) {
@@ -98,19 +349,211 @@ namespace cx {
         }
     }
 
-    void Buffer::Flush()
-    {
-        // [최적화 1] 변경할 내용이 없거나 버퍼가 비었으면 조기 리턴
-        if (back_buffer_.empty() || front_buffer_.empty()) return;
+    // 속성 비트마스크를 SGR 시퀀스로 변환 (예: "\033[0;1;4m")
+    static void AppendAttrSgr(std::string& out, uint8_t attr) {
+        static const char* codes[8] = { ";1", ";2", ";3", ";4", ";5", ";7", ";8", ";9" };
 
-        // [최적화 2] StringStream 대신 std::string 사용 및 메모리 예약
-        // 화면 크기 * (Color + Move + Char) 정도의 넉넉한 크기 예약
-        // 빈번한 메모리 재할당을 막아 성능을 높입니다.
-        std::string out_buf;
-        out_buf.reserve(width_ * height_ * 32);
+        out += "\033[0";
+        for (int bit = 0; bit < 8; ++bit) {
+            if (attr & (1 << bit)) out += codes[bit];
+        }
+        out += 'm';
+    }
+
+    void Buffer::CopyFlushOptions(const Buffer& other) {
+        output_budget_ = other.output_budget_;
+        parallel_threads_ = other.parallel_threads_;
+        parallel_min_cells_ = other.parallel_min_cells_;
+        scroll_detection_ = other.scroll_detection_;
+    }
+
+    // =========================================================================
+    // 셀 비교 (SIMD)
+    // =========================================================================
+    // Cell은 고정 32바이트이고 사용하지 않는 바이트가 항상 0이므로, 바이트가 같으면 내용도 같습니다.
+    // [from, to) 구간에서 back과 front의 바이트가 처음 다른 셀 위치를 반환합니다. (없으면 to)
+    static_assert(std::is_trivially_copyable_v<Cell>, "Cell must be trivially copyable for byte-wise compare");
+
+    using MismatchFn = int (*)(const Cell* back, const Cell* front, int from, int to);
+
+    static int FindMismatchScalar(const Cell* back, const Cell* front, int from, int to) {
+        for (int x = from; x < to; ++x) {
+            if (std::memcmp(&back[x], &front[x], sizeof(Cell)) != 0) return x;
+        }
+        return to;
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    // SSE2 (x86-64 기본, i386은 -msse2 없이도 쓸 수 있게 target 지정 후 실행 시 확인): 셀 하나를 16바이트 비교 두 번으로 확인
+    __attribute__((target("sse2")))
+    static int FindMismatchSse2(const Cell* back, const Cell* front, int from, int to) {
+        for (int x = from; x < to; ++x) {
+            const __m128i* a = reinterpret_cast<const __m128i*>(&back[x]);
+            const __m128i* b = reinterpret_cast<const __m128i*>(&front[x]);
+            __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128(a), _mm_loadu_si128(b)),
+                                       _mm_cmpeq_epi8(_mm_loadu_si128(a + 1), _mm_loadu_si128(b + 1)));
+            if (_mm_movemask_epi8(eq) != 0xFFFF) return x;
+        }
+        return to;
+    }
+
+    // AVX2: 셀 하나가 32바이트 비교 한 번, 4셀씩 결과를 모아 분기 한 번으로 건너뜀
+    __attribute__((target("avx2")))
+    static inline __m256i CellEqAvx2(const Cell* a, const Cell* b) {
+        return _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a)),
+                                 _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)));
+    }
+
+    __attribute__((target("avx2")))
+    static int FindMismatchAvx2(const Cell* back, const Cell* front, int from, int to) {
+        int x = from;
+        for (; x + 4 <= to; x += 4) {
+            __m256i eq = _mm256_and_si256(_mm256_and_si256(CellEqAvx2(&back[x], &front[x]), CellEqAvx2(&back[x + 1], &front[x + 1])),
+                                          _mm256_and_si256(CellEqAvx2(&back[x + 2], &front[x + 2]), CellEqAvx2(&back[x + 3], &front[x + 3])));
+            if (_mm256_movemask_epi8(eq) != -1) break; // 이 4셀 안에 다른 셀이 있음
+        }
+        for (; x < to; ++x) {
+            if (_mm256_movemask_epi8(CellEqAvx2(&back[x], &front[x])) != -1) return x;
+        }
+        return to;
+    }
+#endif
+
+    // SIMD를 끈 비교 (SetSimdDiff(false), 벤치마크 기준): 셀마다 operator!=로 내용 비교
+    static int FindMismatchCell(const Cell* back, const Cell* front, int from, int to) {
+        for (int x = from; x < to; ++x) {
+            if (back[x] != front[x]) return x;
+        }
+        return to;
+    }
+
+    struct MismatchImpl {
+        MismatchFn fn;
+        const char* name;
+    };
+
+    // 실행 중인 CPU에 맞는 구현 선택 (처음 한 번)
+    static const MismatchImpl& BestMismatch() {
+        static const MismatchImpl impl = [] {
+#if ( defined(__x86_64__) || defined(__i386__) ) && ( defined(__GNUC__) || defined(__clang__) )
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) return MismatchImpl{ FindMismatchAvx2, "avx2" };
+            if (__builtin_cpu_supports("sse2")) return MismatchImpl{ FindMismatchSse2, "sse2" };
+#endif
+            return MismatchImpl{ FindMismatchScalar, "scalar" };
+        }();
+        return impl;
+    }
+
+    static std::atomic<bool> g_simd_diff{true};
+
+    static MismatchFn CurrentMismatchFn() {
+        return g_simd_diff.load(std::memory_order_relaxed) ? BestMismatch().fn : FindMismatchCell;
+    }
+
+    void Buffer::SetSimdDiff(bool enable) {
+        g_simd_diff.store(enable, std::memory_order_relaxed);
+    }
+
+    const char* Buffer::GetDiffScanName() {
+        return g_simd_diff.load(std::memory_order_relaxed) ? BestMismatch().name : "cell";
+    }
+
+    // Flush 병렬 Diff용 작은 스레드 풀 (처음 사용할 때 생성, 프로세스 종료까지 유지)
+    // 호출 스레드도 구간 하나를 맡아 처리하므로, threads개 중 threads - 1개만 워커로 둡니다.
+    class DiffPool {
+    public:
+        static DiffPool& Get() {
+            static DiffPool pool;
+            return pool;
+        }
+
+        // fn(0) ~ fn(count - 1)을 최대 threads개 스레드로 나누어 실행하고 모두 끝날 때까지 대기
+        void Run(int count, int threads, const std::function<void(int)>& fn) {
+            std::lock_guard<std::mutex> run_lock(run_mtx_); // 여러 Buffer가 동시에 Flush해도 작업은 하나씩
+
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                while (static_cast<int>(workers_.size()) < threads - 1) {
+                    workers_.emplace_back(&DiffPool::WorkerLoop, this);
+                }
+                job_ = &fn;
+                job_count_ = count;
+                next_.store(0, std::memory_order_relaxed);
+                completed_.store(0, std::memory_order_relaxed);
+                generation_++;
+            }
+            cv_.notify_all();
+
+            RunBands();
+
+            // 모든 구간이 끝나고, 작업을 잡은 워커가 모두 빠져나온 뒤에 fn을 놓음
+            std::unique_lock<std::mutex> lock(mtx_);
+            done_cv_.wait(lock, [&] { return completed_.load(std::memory_order_acquire) == count && busy_ == 0; });
+            job_ = nullptr;
+        }
+
+    private:
+        DiffPool() = default;
+
+        ~DiffPool() {
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+            for (auto& worker : workers_) worker.join();
+        }
 
+        void RunBands() {
+            int band;
+            while ((band = next_.fetch_add(1, std::memory_order_relaxed)) < job_count_) {
+                (*job_)(band);
+                completed_.fetch_add(1, std::memory_order_release);
+            }
+        }
+
+        void WorkerLoop() {
+            uint64_t seen = 0;
+            for (;;) {
+                std::unique_lock<std::mutex> lock(mtx_);
+                cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+
+                seen = generation_;
+                if (job_ == nullptr) continue; // 늦게 깨어남: 이미 끝난 작업
+                busy_++;
+                lock.unlock();
+
+                RunBands();
+
+                lock.lock();
+                busy_--;
+                if (busy_ == 0) done_cv_.notify_all();
+            }
+        }
+
+        std::mutex run_mtx_;
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        std::condition_variable done_cv_;
+        std::vector<std::thread> workers_;
+
+        const std::function<void(int)>* job_ = nullptr;
+        int job_count_ = 0;
+        std::atomic<int> next_{0};
+        std::atomic<int> completed_{0};
+        int busy_ = 0;
+        uint64_t generation_ = 0;
+        bool stop_ = false;
+    };
+
+    void Buffer::DiffRows(int y_begin, int y_end, ColorDepth depth, std::string& out_buf) {
+        // 구간마다 커서 위치와 SGR 상태를 모르는 상태에서 시작
+        // (첫 변경 셀에서 절대 좌표 이동과 전체 SGR을 출력하므로, 구간별 출력을 그대로 이어 붙일 수 있음)
         Color last_fg = Color::White;
         Color last_bg = Color::Black;
+        uint8_t last_attr = ATTR_NONE;
         bool color_set = false;
 
         // 터미널 커서 위치 추적 (1-based)
@@ -118,15 +561,32 @@ namespace cx {
         int term_cursor_y = -1;
         int term_cursor_x = -1;
 
-        for (int y = 0; y < height_; ++y) {
+        const MismatchFn find_mismatch = CurrentMismatchFn();
+
+        for (int y = y_begin; y < y_end; ++y) {
+            // 행 해시가 같으면 정수 비교 한 번으로 행 전체를 건너뜀
+            // (64비트 해시가 우연히 같을 확률은 무시할 수 있을 만큼 작음)
+            if (back_hash_[y] == front_hash_[y]) continue;
+            front_hash_[y] = back_hash_[y]; // 아래에서 바이트가 다른 셀을 모두 동기화하므로 Front 행은 Back 행과 같아짐
+
+            const Cell* back_row = back_buffer_[y].data();
+            const Cell* front_row = front_buffer_[y].data();
+
             for (int x = 0; x < width_; ++x) {
+                // 1. 변경 감지 (Diff)
+                // 이전 프레임과 같은 구간은 바이트 비교(SIMD)로 한 번에 건너뜀
+                x = find_mismatch(back_row, front_row, x, width_);
+                if (x >= width_) break;
+
                 // [참고] 기존 2D 벡터 구조 유지
                 Cell& back = back_buffer_[y][x];
                 Cell& front = front_buffer_[y][x];
 
-                // 1. 변경 감지 (Diff)
-                // 이전 프레임과 같다면 렌더링 건너뜀
-                if (!(back != front)) continue;
+                // 바이트는 다르지만 내용은 같음 (폭 계산 값 등): 동기화만 하고 렌더링 건너뜀
+                if (!(back != front)) {
+                    front = back;
+                    continue;
+                }
 
                 // 2. Wide char 뒷부분 스킵
                 // (한글 등 2칸 문자 뒤의 더미 데이터는 그리지 않음)
@@ -147,13 +607,19 @@ namespace cx {
                     term_cursor_x = target_x;
                 }
 
-                // 4. 색상 변경 최적화 (Stateful)
+                // 4. 속성 & 색상 변경 최적화 (Stateful)
+                // 속성은 SGR 0으로 초기화 후 다시 지정하므로, 색상도 다시 출력해야 함
+                if (!color_set || back.attr != last_attr) {
+                    AppendAttrSgr(out_buf, back.attr);
+                    last_attr = back.attr;
+                    color_set = false;
+                }
                 if (!color_set || back.fg != last_fg) {
-                    out_buf += back.fg.ToAnsiForeground();
+                    out_buf += back.fg.ToAnsiForeground(depth);
                     last_fg = back.fg;
                 }
                 if (!color_set || back.bg != last_bg) {
-                    out_buf += back.bg.ToAnsiBackground();
+                    out_buf += back.bg.ToAnsiBackground(depth);
                     last_bg = back.bg;
                 }
                 color_set = true;
@@ -165,15 +631,156 @@ namespace cx {
                 front = back;
 
                 // 7. 커서 위치 추적 업데이트
-                // 문자 너비만큼 x 좌표 증가 (한글 +2, 영문 +1)
-                int width_step = (int)Util::GetStringWidth(back.ch);
-                term_cursor_x += width_step;
+                // 그릴 때 계산해 둔 너비만큼 x 좌표 증가 (한글 +2, 영문 +1)
+                term_cursor_x += back.width;
             }
         }
+    }
+
+    void Buffer::ScrollMovedRows(std::string& out_buf) {
+        constexpr int MIN_ROWS = 4;     // 너무 작은 화면은 다시 그리는 편이 짧음
+        constexpr int MAX_PROBES = 8;   // 이동 후보를 확인할 변경 행 수 (행마다 O(height) 비교)
+        if (height_ < MIN_ROWS) return;
+
+        // 터미널 스크롤은 줄 전체를 옮기므로, 버퍼 가로 폭이 터미널과 다르면 버퍼 밖 내용까지 옮겨짐
+        TermSize term = Screen::GetSize();
+        if (width_ != term.cols || height_ > term.rows) return;
+
+        int unchanged = 0;
+        for (int y = 0; y < height_; ++y) {
+            if (back_hash_[y] == front_hash_[y]) unchanged++;
+        }
+        if (unchanged == height_) return;
+
+        // Front 행 해시 -> 행 위치 (같은 행이 여러 개면 첫 번째, 빈 줄처럼 흔한 행은 후보로 쓸모가 적음)
+        row_index_.clear();
+        for (int y = height_ - 1; y >= 0; --y) row_index_[front_hash_[y]] = y;
+
+        // 스크롤하면 터미널이 비우는 줄 (SGR 0 후 스크롤하므로 기본 색상의 공백)
+        Cell blank;
+        blank.fg = Color::Reset;
+        blank.bg = Color::Reset;
+        const uint64_t blank_hash = RowHash(std::vector<Cell>(width_, blank));
+
+        int best_shift = 0, best_top = 0, best_bottom = 0, best_unchanged = unchanged;
+        int probes = 0;
+        for (int y = 0; y < height_ && probes < MAX_PROBES; ++y) {
+            if (back_hash_[y] == front_hash_[y]) continue;
+            auto it = row_index_.find(back_hash_[y]);
+            if (it == row_index_.end()) continue;
+            probes++;
+
+            // shift > 0: 내용이 위로 이동 (Back[y] == Front[y + shift])
+            int shift = it->second - y;
+            int first = height_, last = -1;
+            for (int yy = std::max(0, -shift); yy < std::min(height_, height_ - shift); ++yy) {
+                if (back_hash_[yy] != front_hash_[yy + shift]) continue;
+                first = std::min(first, yy);
+                last = yy;
+            }
+
+            // 옮겨진 행을 모두 포함하는 스크롤 영역 [top, bottom] (밖의 행은 그대로)
+            int top = std::min(first, first + shift);
+            int bottom = std::max(last, last + shift);
+            int after = unchanged;
+            for (int yy = top; yy <= bottom; ++yy) {
+                int src = yy + shift;
+                uint64_t moved = (src >= top && src <= bottom) ? front_hash_[src] : blank_hash;
+                after += (back_hash_[yy] == moved) - (back_hash_[yy] == front_hash_[yy]);
+            }
+
+            if (after > best_unchanged) {
+                best_shift = shift;
+                best_top = top;
+                best_bottom = bottom;
+                best_unchanged = after;
+            }
+        }
+
+        // 스크롤로 다시 그리지 않아도 되는 행이 적으면 그대로 둠 (전체를 Diff로 처리)
+        if (best_shift == 0 || best_unchanged - unchanged < std::max(2, height_ / 8)) return;
+
+        // 영역을 지정하여 스크롤하고 해제 (해제하면 커서가 좌상단으로 가지만, Diff는 절대 좌표 이동으로 시작함)
+        int count = std::abs(best_shift);
+        out_buf += "\033[0m\033[" + std::to_string(best_top + 1) + ";" + std::to_string(best_bottom + 1) + "r";
+        out_buf += "\033[" + std::to_string(count) + (best_shift > 0 ? "S" : "T");
+        out_buf += "\033[r";
+
+        // Front도 터미널과 같이 행을 옮기고, 비워진 줄은 공백으로 기록
+        auto first_row = front_buffer_.begin() + best_top;
+        auto last_row = front_buffer_.begin() + best_bottom + 1;
+        auto first_hash = front_hash_.begin() + best_top;
+        auto last_hash = front_hash_.begin() + best_bottom + 1;
+        int blank_from = best_top, blank_to = best_top + count;
+        if (best_shift > 0) {
+            std::rotate(first_row, first_row + count, last_row);
+            std::rotate(first_hash, first_hash + count, last_hash);
+            blank_from = best_bottom + 1 - count;
+            blank_to = best_bottom + 1;
+        }
+        else {
+            std::rotate(first_row, last_row - count, last_row);
+            std::rotate(first_hash, last_hash - count, last_hash);
+        }
+        for (int y = blank_from; y < blank_to; ++y) {
+            std::fill(front_buffer_[y].begin(), front_buffer_[y].end(), blank);
+            front_hash_[y] = blank_hash;
+        }
+        scrolled_frames_++;
+    }
+
+    void Buffer::Flush()
+    {
+        // [최적화 1] 변경할 내용이 없거나 버퍼가 비었으면 조기 리턴
+        if (back_buffer_.empty() || front_buffer_.empty()) return;
+
+        // [최적화 2] 이전 출력이 남아 있으면 먼저 이어서 씀
+        // 그래도 예산보다 많이 남았으면 이번 프레임은 만들지 않음 (Back은 다음 Flush()까지 유지되고,
+        // Front는 출력을 확정한 상태 그대로이므로 다음 Flush()가 밀린 변경을 한 번에 합쳐서 출력)
+        if (!Screen::FlushOutput() && Screen::GetPendingOutput() > output_budget_) {
+            merged_frames_++;
+            return;
+        }
+
+        // [최적화 3] StringStream 대신 std::string 사용 및 메모리 예약
+        // 화면 크기 * (Color + Move + Char) 정도의 넉넉한 크기 예약
+        // 빈번한 메모리 재할당을 막아 성능을 높입니다.
+        std::string out_buf;
+        out_buf.reserve(width_ * height_ * 32);
+
+        // 터미널 기능은 프레임마다 한 번만 조회 (색상 수에 맞춰 변환, 동기화 출력으로 찢어짐 방지)
+        auto caps = Capabilities::Current();
+        ColorDepth depth = caps->color_depth;
+        if (caps->sync_output) out_buf += "\033[?2026h";
+        size_t body_start = out_buf.size();
+
+        // 행 단위로 옮겨진 내용은 터미널 스크롤로 옮기고, 남은 변경만 Diff
+        if (scroll_detection_) ScrollMovedRows(out_buf);
+
+        // 행 구간을 나누어 병렬로 Diff (큰 화면에서만, 구간마다 행이 겹치지 않으므로 잠금 없음)
+        int threads = std::min(parallel_threads_, height_);
+        if (threads > 1 && width_ * height_ >= parallel_min_cells_) {
+            int bands = threads * 2; // 구간별 변경량 차이를 고르게 나누도록 스레드보다 많이 나눔
+            if (bands > height_) bands = height_;
+            if (static_cast<int>(band_out_.size()) < bands) band_out_.resize(bands);
+
+            DiffPool::Get().Run(bands, threads, [&](int band) {
+                std::string& out = band_out_[band];
+                out.clear();
+                DiffRows(height_ * band / bands, height_ * (band + 1) / bands, depth, out);
+            });
+
+            for (int band = 0; band < bands; ++band) out_buf += band_out_[band];
+        }
+        else {
+            DiffRows(0, height_, depth, out_buf);
+        }
 
-        // 최종 출력 (System Call)
-        if (!out_buf.empty()) {
-            std::cout << out_buf << std::flush;
+        // 최종 출력 (System Call, Non-Blocking)
+        // 다 쓰지 못한 나머지는 터미널 출력 큐에 남았다가 다음 Flush() 또는 Screen::DrainOutput()에서 이어서 씀
+        if (out_buf.size() > body_start) {
+            if (caps->sync_output) out_buf += "\033[?2026l";
+            Screen::Write(out_buf);
         }
     }
 
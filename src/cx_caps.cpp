@@ -0,0 +1,387 @@
+#include "cx_caps.hpp"
+#include "cx_device.hpp"
+
+// System Headers
+#include <sys/stat.h>          // mkdir
+#include <unistd.h>            // isatty
+#include <cstdio>              // std::rename
+#include <cstdlib>             // getenv
+#include <cstring>             // strlen
+#include <fstream>             // std::ifstream, std::ofstream
+#include <sstream>             // std::ostringstream
+#include <mutex>               // std::mutex
+#include <condition_variable>  // std::condition_variable
+#include <vector>              // std::vector
+
+namespace cx
+{
+    // 현재 프로필 (Copy-On-Write: 읽는 쪽은 스냅샷을 atomic load로 가져감)
+    static std::shared_ptr<const Capabilities> g_caps;
+    static std::once_flag                      g_caps_once;
+
+    // =========================================================================
+    // terminfo
+    // =========================================================================
+
+    /**
+     * @brief  컴파일된 terminfo 파일에서 색상 수와 트루컬러 표시(RGB, Tc)를 읽습니다.
+     * @return 형식이 올바르지 않으면 false
+     *
+     * @details
+     *   ncurses를 링크하지 않고 파일을 직접 읽습니다. (term(5) 형식)
+     *   - 헤더 : magic, 이름 크기, bool 수, 숫자 수, 문자열 수, 문자열 테이블 크기 (각 16비트)
+     *   - 숫자 : 16비트(magic 0432) 또는 32비트(magic 01036), colors는 13번
+     *   - 확장 영역 : 사용자 정의 이름(RGB, Tc 등)은 값 뒤의 이름 테이블에 있음
+     */
+    static bool ParseTerminfo( const std::string& data, int& colors, bool& has_rgb )
+    {
+        auto u16 = [&]( size_t off ) -> int {
+            if( off + 2 > data.size() ) return -1;
+            return static_cast<uint8_t>( data[off] ) | ( static_cast<uint8_t>( data[off + 1] ) << 8 );
+        };
+        auto s16 = [&]( size_t off ) -> int {
+            int v = u16( off );
+            return ( v < 0 ) ? -1 : static_cast<int16_t>( v );
+        };
+
+        int magic     = u16( 0 );
+        int num_width = ( magic == 0432 ) ? 2 : ( magic == 01036 ) ? 4 : 0;
+        if( num_width == 0 ) return false;
+
+        auto read_num = [&]( size_t off ) -> int {
+            if( num_width == 2 ) return s16( off );
+            if( off + 4 > data.size() ) return -1;
+            return static_cast<int32_t>( static_cast<uint32_t>( u16( off ) ) | ( static_cast<uint32_t>( u16( off + 2 ) ) << 16 ) );
+        };
+
+        int name_size = u16( 2 ), bool_count = u16( 4 ), num_count = u16( 6 ), str_count = u16( 8 ), str_size = u16( 10 );
+        if( name_size < 0 || bool_count < 0 || num_count < 0 || str_count < 0 || str_size < 0 ) return false;
+
+        size_t pos = 12 + name_size + bool_count;
+        if( pos & 1 ) ++pos;
+
+        constexpr int COLORS_INDEX = 13;
+        if( num_count > COLORS_INDEX ) colors = read_num( pos + COLORS_INDEX * num_width );
+
+        pos += num_count * num_width + str_count * 2 + str_size;
+        if( pos & 1 ) ++pos;
+
+        // 확장 영역 (없으면 여기서 끝)
+        if( pos + 10 > data.size() ) return true;
+
+        int ext_bools = u16( pos ), ext_nums = u16( pos + 2 ), ext_strs = u16( pos + 4 );
+        pos += 10;
+
+        size_t bool_pos = pos;
+        pos += ext_bools;
+        if( pos & 1 ) ++pos;
+        size_t num_pos     = pos; pos += ext_nums * num_width;
+        size_t str_off_pos = pos; pos += ext_strs * 2;
+        size_t name_pos    = pos; pos += ( ext_bools + ext_nums + ext_strs ) * 2;
+        size_t table       = pos;
+        if( table > data.size() ) return true;
+
+        // 이름 테이블은 문자열 값들이 끝난 뒤부터 시작
+        size_t names_base = table;
+        for( int i = 0; i < ext_strs; ++i ) {
+            int off = s16( str_off_pos + i * 2 );
+            if( off < 0 || table + off >= data.size() ) continue;
+            size_t end = data.find( '\0', table + off );
+            if( end != std::string::npos ) names_base = std::max( names_base, end + 1 );
+        }
+
+        auto name_at = [&]( int index ) -> std::string {
+            int off = s16( name_pos + index * 2 );
+            if( off < 0 || names_base + off >= data.size() ) return "";
+            return std::string( data.c_str() + names_base + off );
+        };
+
+        for( int i = 0; i < ext_bools; ++i ) {
+            std::string name = name_at( i );
+            if( ( name == "RGB" || name == "Tc" ) && bool_pos + i < data.size() && data[bool_pos + i] == 1 ) has_rgb = true;
+        }
+        for( int i = 0; i < ext_nums; ++i ) {
+            if( name_at( ext_bools + i ) == "RGB" && read_num( num_pos + i * num_width ) > 0 ) has_rgb = true;
+        }
+        return true;
+    }
+
+    /// @brief terminfo 검색 경로에서 $TERM 항목을 찾아 읽습니다.
+    static bool ReadTerminfo( const std::string& term, int& colors, bool& has_rgb )
+    {
+        if( term.empty() || term.find( '/' ) != std::string::npos ) return false;
+
+        std::vector<std::string> dirs;
+        if( const char* env = getenv( "TERMINFO" ) ) dirs.emplace_back( env );
+        if( const char* home = getenv( "HOME" ) )    dirs.emplace_back( std::string( home ) + "/.terminfo" );
+        if( const char* list = getenv( "TERMINFO_DIRS" ) ) {
+            std::istringstream ss( list );
+            for( std::string dir; std::getline( ss, dir, ':' ); ) {
+                if( !dir.empty() ) dirs.push_back( dir );
+            }
+        }
+        for( const char* dir : { "/etc/terminfo", "/lib/terminfo", "/usr/share/terminfo", "/usr/lib/terminfo" } ) {
+            dirs.emplace_back( dir );
+        }
+
+        // 하위 폴더는 첫 글자 (Linux) 또는 첫 글자의 16진수 (macOS)
+        char hex[3];
+        snprintf( hex, sizeof(hex), "%02x", static_cast<unsigned char>( term[0] ) );
+
+        for( const auto& dir : dirs ) {
+            for( const std::string& sub : { std::string( 1, term[0] ), std::string( hex ) } ) {
+                std::ifstream file( dir + "/" + sub + "/" + term, std::ios::binary );
+                if( !file ) continue;
+
+                std::ostringstream data;
+                data << file.rdbuf();
+                return ParseTerminfo( data.str(), colors, has_rgb );
+            }
+        }
+        return false;
+    }
+
+    // =========================================================================
+    // Detection
+    // =========================================================================
+
+    /// @brief 환경 변수와 terminfo로 기능을 추정합니다. (터미널 질의 없음)
+    static Capabilities DetectFromEnvironment( void )
+    {
+        Capabilities caps;
+
+        const char* term_env = getenv( "TERM" );
+        caps.term = term_env ? term_env : "";
+
+        // 여러 에뮬레이터가 같은 $TERM(xterm-256color 등)을 쓰므로, 캐시는 프로그램과 버전까지 구분
+        if( const char* program = getenv( "TERM_PROGRAM" ); program && *program ) {
+            caps.term_program = program;
+            if( const char* ver = getenv( "TERM_PROGRAM_VERSION" ); ver && *ver ) caps.term_program += std::string( " " ) + ver;
+        }
+
+        if( caps.term.empty() || caps.term == "dumb" ) {
+            caps.color_depth     = ColorDepth::MONO;
+            caps.sgr_mouse       = false;
+            caps.bracketed_paste = false;
+            return caps;
+        }
+
+        // Linux 콘솔 : 16색, 마우스 보고 없음
+        if( caps.term == "linux" ) {
+            caps.color_depth = ColorDepth::ANSI16;
+            caps.sgr_mouse   = false;
+            return caps;
+        }
+
+        // 1. COLORTERM (대부분의 트루컬러 터미널이 설정)
+        const char* colorterm = getenv( "COLORTERM" );
+        if( colorterm && ( strcmp( colorterm, "truecolor" ) == 0 || strcmp( colorterm, "24bit" ) == 0 ) ) {
+            caps.color_depth = ColorDepth::TRUECOLOR;
+            return caps;
+        }
+
+        // 2. terminfo
+        int  colors  = -1;
+        bool has_rgb = false;
+        if( ReadTerminfo( caps.term, colors, has_rgb ) ) {
+            if     ( has_rgb || colors >= ( 1 << 24 ) ) caps.color_depth = ColorDepth::TRUECOLOR;
+            else if( colors >= 256 )                    caps.color_depth = ColorDepth::ANSI256;
+            else if( colors >= 8 )                      caps.color_depth = ColorDepth::ANSI16;
+            else                                        caps.color_depth = ColorDepth::MONO;
+            return caps;
+        }
+
+        // 3. terminfo가 없으면 이름으로 추정 (모르는 터미널은 기존처럼 트루컬러로 가정)
+        if( caps.term.find( "256color" ) != std::string::npos ) caps.color_depth = ColorDepth::ANSI256;
+        return caps;
+    }
+
+    // =========================================================================
+    // Cache
+    // =========================================================================
+
+    std::string Capabilities::GetCachePath( const std::string& term, const std::string& term_program )
+    {
+        std::string base;
+        if( const char* xdg = getenv( "XDG_CACHE_HOME" ); xdg && *xdg ) base = xdg;
+        else if( const char* home = getenv( "HOME" ); home && *home )   base = std::string( home ) + "/.cache";
+        else return "";
+
+        // 파일 이름에 쓸 수 없는 문자는 '_'로 치환
+        std::string name = term.empty() ? "unknown" : term;
+        if( !term_program.empty() ) name += "-" + term_program.substr( 0, term_program.find( ' ' ) );
+        for( char& ch : name ) {
+            if( ch == '/' || ch == '.' || ch == ' ' ) ch = '_';
+        }
+        return base + "/consolex/" + name + ".caps";
+    }
+
+    static bool LoadCache( const std::string& path, Capabilities& caps )
+    {
+        std::ifstream file( path );
+        if( !file ) return false;
+
+        Capabilities loaded = caps;
+        bool         term_ok    = false;
+        bool         program_ok = caps.term_program.empty(); // 예전 캐시 파일에는 항목이 없음
+        bool         depth_ok   = true;
+
+        for( std::string line; std::getline( file, line ); ) {
+            size_t eq = line.find( '=' );
+            if( line.empty() || line[0] == '#' || eq == std::string::npos ) continue;
+
+            std::string key   = line.substr( 0, eq );
+            std::string value = line.substr( eq + 1 );
+            bool        on    = ( value == "1" );
+
+            if     ( key == "term"            ) term_ok    = ( value == caps.term );
+            else if( key == "term_program"    ) program_ok = ( value == caps.term_program );
+            else if( key == "version"         ) loaded.version = value;
+            else if( key == "color_depth"     ) {
+                // 손상되거나 직접 고친 값이면 캐시 전체를 버리고 다시 질의
+                depth_ok = ( value.size() == 1 && value[0] >= '0' && value[0] <= '3' );
+                if( depth_ok ) loaded.color_depth = static_cast<ColorDepth>( value[0] - '0' );
+            }
+            else if( key == "sgr_mouse"       ) loaded.sgr_mouse       = on;
+            else if( key == "bracketed_paste" ) loaded.bracketed_paste = on;
+            else if( key == "sync_output"     ) loaded.sync_output     = on;
+            else if( key == "kitty_keyboard"  ) loaded.kitty_keyboard  = on;
+        }
+
+        // 다른 $TERM이나 다른 터미널 프로그램(버전)의 캐시는 사용하지 않음
+        if( !term_ok || !program_ok || !depth_ok ) return false;
+
+        loaded.probed = true;
+        caps = loaded;
+        return true;
+    }
+
+    static void SaveCache( const std::string& path, const Capabilities& caps )
+    {
+        if( path.empty() ) return;
+
+        // 폴더 생성 (.../consolex), 이미 있으면 실패해도 무시
+        size_t slash = path.rfind( '/' );
+        size_t base  = path.rfind( '/', slash - 1 );
+        mkdir( path.substr( 0, base ).c_str(), 0755 );
+        mkdir( path.substr( 0, slash ).c_str(), 0755 );
+
+        // 임시 파일에 쓴 뒤 교체 (동시에 실행된 다른 프로세스가 반쯤 쓴 파일을 읽지 않도록)
+        std::string tmp = path + "." + std::to_string( getpid() );
+        {
+            std::ofstream file( tmp, std::ios::trunc );
+            if( !file ) return;
+
+            file << "# ConsoleX terminal capabilities (delete to probe again)\n"
+                 << "term="            << caps.term                                     << "\n"
+                 << "term_program="    << caps.term_program                             << "\n"
+                 << "version="         << caps.version                                  << "\n"
+                 << "color_depth="     << static_cast<int>( caps.color_depth )          << "\n"
+                 << "sgr_mouse="       << caps.sgr_mouse                                << "\n"
+                 << "bracketed_paste=" << caps.bracketed_paste                          << "\n"
+                 << "sync_output="     << caps.sync_output                              << "\n"
+                 << "kitty_keyboard="  << caps.kitty_keyboard                           << "\n";
+        }
+        std::rename( tmp.c_str(), path.c_str() );
+    }
+
+    // =========================================================================
+    // Public API
+    // =========================================================================
+
+    std::shared_ptr<const Capabilities> Capabilities::Current( void )
+    {
+        std::call_once( g_caps_once, [] {
+            Capabilities caps = DetectFromEnvironment();
+            LoadCache( GetCachePath( caps.term, caps.term_program ), caps ); // 이전에 확정한 값이 있으면 사용
+            std::atomic_store( &g_caps, std::shared_ptr<const Capabilities>( std::make_shared<Capabilities>( caps ) ) );
+        } );
+        return std::atomic_load( &g_caps );
+    }
+
+    void Capabilities::Set( const Capabilities& caps )
+    {
+        Current(); // 최초 추정이 나중에 덮어쓰지 않도록 먼저 초기화
+        std::atomic_store( &g_caps, std::shared_ptr<const Capabilities>( std::make_shared<Capabilities>( caps ) ) );
+    }
+
+    std::shared_ptr<const Capabilities> Capabilities::Probe( std::chrono::milliseconds timeout, bool use_cache )
+    {
+        Capabilities caps = DetectFromEnvironment();
+        std::string  path = GetCachePath( caps.term, caps.term_program );
+
+        if( use_cache && LoadCache( path, caps ) ) {
+            Set( caps );
+            return Current();
+        }
+
+        // 파이프/파일로 연결되어 있으면 응답을 받을 수 없음
+        if( !isatty( STDIN_FILENO ) || !isatty( STDOUT_FILENO ) || caps.term.empty() || caps.term == "dumb" ) {
+            Set( caps );
+            return Current();
+        }
+
+        struct ProbeState
+        {
+            std::mutex              mtx;
+            std::condition_variable cv;
+            bool                    done     = false;
+            bool                    answered = false; // DA1 응답 수신 (터미널이 질의에 응답함)
+            bool                    has_rgb  = false;
+            Capabilities            caps;
+        };
+        auto state  = std::make_shared<ProbeState>();
+        state->caps = caps;
+
+        // 응답 처리 (Reader 스레드에서 호출되므로 state 잠금 후 갱신)
+        auto on_reply = [state]( void (*apply)( ProbeState&, const QueryReply& ) ) {
+            return [state, apply]( const QueryReply& reply ) {
+                std::lock_guard<std::mutex> lock( state->mtx );
+                if( reply.ok ) apply( *state, reply );
+            };
+        };
+
+        // DECRQM : 응답이 없으면(DECRQM 미지원) 추정값 유지
+        Device::Query( TermQuery::MODE, 2026, on_reply( []( ProbeState& s, const QueryReply& r ) { s.caps.sync_output     = r.IsModeSupported(); } ), timeout );
+        Device::Query( TermQuery::MODE, 2004, on_reply( []( ProbeState& s, const QueryReply& r ) { s.caps.bracketed_paste = r.IsModeSupported(); } ), timeout );
+        Device::Query( TermQuery::MODE, 1006, on_reply( []( ProbeState& s, const QueryReply& r ) { s.caps.sgr_mouse       = r.IsModeSupported(); } ), timeout );
+
+        Device::Query( TermQuery::KEYBOARD_FLAGS, on_reply( []( ProbeState& s, const QueryReply& ) { s.caps.kitty_keyboard = true; } ), timeout );
+        Device::Query( TermQuery::VERSION,        on_reply( []( ProbeState& s, const QueryReply& r ) { s.caps.version = r.text; } ), timeout );
+
+        // XTGETTCAP : terminfo 확장 이름 RGB / Tc가 있으면 트루컬러
+        for( const char* name : { "RGB", "Tc" } ) {
+            Device::Query( TermQuery::TERMCAP, name, on_reply( []( ProbeState& s, const QueryReply& r ) {
+                if( !r.params.empty() && r.params[0] == 1 ) s.has_rgb = true;
+            } ), timeout );
+        }
+
+        Device::Query( TermQuery::SECONDARY_DA, on_reply( []( ProbeState& s, const QueryReply& r ) {
+            if( s.caps.version.empty() && r.params.size() >= 2 ) {
+                s.caps.version = "DA2 " + std::to_string( r.params[0] ) + ";" + std::to_string( r.params[1] );
+            }
+        } ), timeout );
+
+        // DA1 : 모든 터미널이 응답하므로 마지막에 보내서 끝 표시로 사용
+        Device::Query( TermQuery::PRIMARY_DA, [state]( const QueryReply& reply ) {
+            std::lock_guard<std::mutex> lock( state->mtx );
+            state->answered = reply.ok;
+            state->done     = true;
+            state->cv.notify_all();
+        }, timeout );
+
+        {
+            std::unique_lock<std::mutex> lock( state->mtx );
+            state->cv.wait( lock, [&] { return state->done; } );
+
+            caps        = state->caps;
+            caps.probed = state->answered;
+            if( state->has_rgb ) caps.color_depth = ColorDepth::TRUECOLOR;
+        }
+
+        Set( caps );
+        if( caps.probed ) SaveCache( path, caps );
+        return Current();
+    }
+
+} // namespace cx
@@ -2,7 +2,9 @@
 
 #include <iomanip>
 #include <sstream>
-#include <algorithm> // std::clamp if needed
+#include <algorithm> // std::clamp
+#include <cstdlib>   // std::abs
+#include <cstdint>   // INT32_MAX
 #include <regex>
 
 namespace cx
@@ -82,6 +84,33 @@ namespace cx
         }
     }
 
+    Color Color::FromAnsi256( uint8_t index )
+    {
+        // 0~15: xterm 기본 16색
+        static const Rgb base16[16] = {
+            {   0,   0,   0 }, { 205,   0,   0 }, {   0, 205,   0 }, { 205, 205,   0 },
+            {   0,   0, 238 }, { 205,   0, 205 }, {   0, 205, 205 }, { 229, 229, 229 },
+            { 127, 127, 127 }, { 255,   0,   0 }, {   0, 255,   0 }, { 255, 255,   0 },
+            {  92,  92, 255 }, { 255,   0, 255 }, {   0, 255, 255 }, { 255, 255, 255 }
+        };
+
+        if( index < 16 ) {
+            const Rgb& c = base16[index];
+            return Color( c.r, c.g, c.b );
+        }
+
+        // 16~231: 6x6x6 색상 큐브
+        if( index < 232 ) {
+            static const uint8_t level[6] = { 0, 95, 135, 175, 215, 255 };
+            int i = index - 16;
+            return Color( level[( i / 36 ) % 6], level[( i / 6 ) % 6], level[i % 6] );
+        }
+
+        // 232~255: 회색조 (8 ~ 238)
+        uint8_t gray = static_cast<uint8_t>( 8 + ( index - 232 ) * 10 );
+        return Color( gray, gray, gray );
+    }
+
     std::string Color::ToAnsiForeground() const
     {
         if( type_ == Type::RESET ) return "\033[0m"; // Reset All
@@ -104,6 +133,71 @@ namespace cx
                               std::to_string( rgb_.b ) + "m";
     }
 
+    /// @brief 두 색의 거리 (제곱, 사람 눈의 민감도에 맞춘 가중치)
+    static int ColorDistance( const Rgb& a, const Rgb& b )
+    {
+        int dr = a.r - b.r, dg = a.g - b.g, db = a.b - b.b;
+        return 2 * dr * dr + 4 * dg * dg + 3 * db * db;
+    }
+
+    uint8_t Color::ToAnsi256() const
+    {
+        // 1. 6x6x6 큐브에서 가장 가까운 칸
+        static const uint8_t level[6] = { 0, 95, 135, 175, 215, 255 };
+        auto nearest_level = []( uint8_t v ) {
+            int best = 0;
+            for( int i = 1; i < 6; ++i ) {
+                if( std::abs( level[i] - v ) < std::abs( level[best] - v ) ) best = i;
+            }
+            return best;
+        };
+        int ri = nearest_level( rgb_.r ), gi = nearest_level( rgb_.g ), bi = nearest_level( rgb_.b );
+        Rgb cube { level[ri], level[gi], level[bi] };
+
+        // 2. 회색조(232~255)에서 가장 가까운 단계
+        int avg  = ( rgb_.r + rgb_.g + rgb_.b ) / 3;
+        int gi24 = std::clamp( ( avg - 8 + 5 ) / 10, 0, 23 );
+        uint8_t g = static_cast<uint8_t>( 8 + gi24 * 10 );
+        Rgb gray { g, g, g };
+
+        if( ColorDistance( rgb_, gray ) < ColorDistance( rgb_, cube ) )
+            return static_cast<uint8_t>( 232 + gi24 );
+        return static_cast<uint8_t>( 16 + ri * 36 + gi * 6 + bi );
+    }
+
+    uint8_t Color::ToAnsi16() const
+    {
+        uint8_t best      = 0;
+        int     best_dist = INT32_MAX;
+        for( uint8_t i = 0; i < 16; ++i ) {
+            int dist = ColorDistance( rgb_, FromAnsi256( i ).rgb_ );
+            if( dist < best_dist ) { best = i; best_dist = dist; }
+        }
+        return best;
+    }
+
+    std::string Color::ToAnsiForeground( ColorDepth depth ) const
+    {
+        if( type_ != Type::RGB || depth == ColorDepth::TRUECOLOR ) return ToAnsiForeground();
+        if( depth == ColorDepth::MONO ) return "";
+
+        if( depth == ColorDepth::ANSI256 ) return "\033[38;5;" + std::to_string( ToAnsi256() ) + "m";
+
+        uint8_t idx = ToAnsi16(); // 0~7: SGR 30~37, 8~15: SGR 90~97
+        return "\033[" + std::to_string( idx < 8 ? 30 + idx : 90 + idx - 8 ) + "m";
+    }
+
+    std::string Color::ToAnsiBackground( ColorDepth depth ) const
+    {
+        if( type_ != Type::RGB || depth == ColorDepth::TRUECOLOR ) return ToAnsiBackground();
+        if( depth == ColorDepth::MONO ) return "";
+
+        if( depth == ColorDepth::ANSI256 ) return "\033[48;5;" + std::to_string( ToAnsi256() ) + "m";
+
+        uint8_t idx = ToAnsi16(); // 0~7: SGR 40~47, 8~15: SGR 100~107
+        return "\033[" + std::to_string( idx < 8 ? 40 + idx : 100 + idx - 8 ) + "m";
+    }
+
     std::string Color::ToHex() const
     {
         if( type_ != Type::RGB )
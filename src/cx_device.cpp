@@ -1,13 +1,21 @@
 #include "cx_device.hpp"
+#include "cx_caps.hpp"
+#include "cx_queue.hpp"
+#include "cx_keymap.hpp"
+#include "cx_util.hpp"
 
 // System Headers
 #include <sys/eventfd.h>
-#include <sys/select.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
 #include <sys/ioctl.h>
 #include <signal.h>
 #include <iostream>
 #include <cstring>
 #include <algorithm>
+#include <cmath>             // std::ceil, std::fabs
+#include <cstdlib>           // getenv
+#include <condition_variable>
 
 namespace cx
 {
@@ -15,17 +23,264 @@ namespace cx
     // 전역변수가 꼭 필요한 매우매우 드문 케이스
     static int g_signal_event_fd = -1;
 
+    // Reader 스레드에 전달할 이벤트 비트 (시그널 핸들러에서도 사용하므로 전역)
+    // eventfd는 "깨우기" 용도로만 쓰고, 무슨 일이 있었는지는 이 비트로 전달합니다.
+    // (eventfd 값은 write 할 때마다 더해지므로, 값 자체로 이벤트 종류를 구분할 수 없음)
+    static std::atomic<uint32_t> g_pending_events { 0 };
+
+    // 이 스레드가 GetInput()으로 마지막에 받은 마우스 상태 (GetMouseState()에서 사용)
+    static thread_local MouseState t_last_mouse;
+
+    // =========================================================================
+    // Subscriber Channel
+    // =========================================================================
+
+    /**
+     * @brief 구독자 하나의 이벤트 큐와 대기 장치
+     *
+     * @details
+     *   큐 자체는 Lock-Free이며, 소비자가 잠들어 있을 때(waiters > 0)만
+     *   생산자가 mutex를 잡고 깨웁니다. 평상시 Push/Pop 경로에는 잠금이 없습니다.
+     */
+    struct Device::Channel
+    {
+        Channel( size_t capacity, bool loop_events )
+            : queue( capacity ), wants_loop_events( loop_events ) {}
+
+        MpmcQueue<Event>    queue;
+        const bool          wants_loop_events; // FD_EVENT, FRAME_EVENT 수신 여부
+        std::atomic<size_t> dropped { 0 };
+        std::atomic<bool>   frame_pending { false }; // 꺼내지 않은 FRAME_EVENT 존재 (새 틱을 쌓지 않음)
+
+        // 대기 중인 소비자 깨우기
+        std::atomic<int>        waiters { 0 };
+        std::mutex              wait_mtx;
+        std::condition_variable cv;
+
+        // 이 구독자에게 전달되어 재개 대기 중인 fd 목록
+        std::mutex       rearm_mtx;
+        std::vector<int> rearm_fds;
+
+        // 연속 이벤트 병합 (CoalesceFlag)
+        // 병합 중 꺼낸 다른 종류의 이벤트는 stash에 보관했다가 다음 Pop()에서 돌려줌
+        std::atomic<uint8_t> coalesce  { COALESCE_NONE };
+        std::atomic<bool>    has_stash { false };
+        std::mutex           stash_mtx;
+        Event                stash;
+
+        /// @brief 큐에 넣습니다. (가득 차서 버렸으면 false)
+        bool Push( const Event& event )
+        {
+            if( !queue.TryPush( event ) ) {
+                dropped.fetch_add( 1, std::memory_order_relaxed );
+                return false;
+            }
+
+            // 소비자의 waiters 증가 -> 큐 확인 순서와 짝을 이루는 fence (깨우기 누락 방지)
+            std::atomic_thread_fence( std::memory_order_seq_cst );
+            if( waiters.load( std::memory_order_relaxed ) > 0 ) {
+                std::lock_guard<std::mutex> lock( wait_mtx );
+                cv.notify_all();
+            }
+            return true;
+        }
+
+        /// @brief 정책상 앞 이벤트(prev)를 next로 대체해도 되는지 확인
+        static bool CanMerge( uint8_t flags, const Event& prev, const Event& next )
+        {
+            if( ( flags & COALESCE_DRAG ) && prev.IsMouse() && next.IsMouse() ) {
+                return prev.mouse.action == MouseAction::DRAG &&
+                       next.mouse.action == MouseAction::DRAG &&
+                       prev.mouse.button == next.mouse.button;
+            }
+            if( ( flags & COALESCE_RESIZE ) && prev.IsResize() && next.IsResize() ) return true;
+            return false;
+        }
+
+        bool Pop( Event& out )
+        {
+            uint8_t flags = coalesce.load( std::memory_order_relaxed );
+
+            if( flags == COALESCE_NONE && !has_stash.load( std::memory_order_acquire ) ) {
+                if( !queue.TryPop( out ) ) return false;
+            }
+            else {
+                std::lock_guard<std::mutex> lock( stash_mtx );
+
+                if( has_stash.load( std::memory_order_relaxed ) ) {
+                    out = std::move( stash );
+                    has_stash.store( false, std::memory_order_release );
+                }
+                else if( !queue.TryPop( out ) ) {
+                    return false;
+                }
+
+                // 같은 종류가 연속으로 쌓여 있으면 마지막 것만 남김
+                Event next;
+                while( queue.TryPop( next ) ) {
+                    if( !CanMerge( flags, out, next ) ) {
+                        stash = std::move( next );
+                        has_stash.store( true, std::memory_order_release );
+                        break;
+                    }
+                    out = std::move( next );
+                }
+            }
+
+            if( out.code == DeviceInputCode::FD_EVENT ) {
+                std::lock_guard<std::mutex> lock( rearm_mtx );
+                rearm_fds.push_back( out.fd );
+            }
+            else if( out.code == DeviceInputCode::FRAME_EVENT ) {
+                // 앱이 프레임을 가져갔으므로 다음 틱부터 다시 전달
+                frame_pending.store( false, std::memory_order_release );
+            }
+            return true;
+        }
+    };
+
+    // =========================================================================
+    // Subscription Implementation
+    // =========================================================================
+
+    Device::Subscription::~Subscription()
+    {
+        Release();
+    }
+
+    Device::Subscription::Subscription( Subscription&& other ) noexcept
+        : channel_( std::move( other.channel_ ) )
+    {
+    }
+
+    Device::Subscription& Device::Subscription::operator=( Subscription&& other ) noexcept
+    {
+        if( this != &other ) {
+            Release();
+            channel_ = std::move( other.channel_ );
+        }
+        return *this;
+    }
+
+    void Device::Subscription::Release( void )
+    {
+        if( channel_ == nullptr ) return;
+
+        GetPtr()->Unsubscribe( channel_ );
+        channel_.reset();
+    }
+
+    void Device::Subscription::Post( const Event& event )
+    {
+        if( channel_ ) channel_->Push( event );
+    }
+
+    void Device::Subscription::SetCoalesce( uint8_t flags )
+    {
+        if( channel_ ) channel_->coalesce.store( flags, std::memory_order_relaxed );
+    }
+
+    size_t Device::Subscription::GetDroppedCount( void ) const
+    {
+        return channel_ ? channel_->dropped.load( std::memory_order_relaxed ) : 0;
+    }
+
+    /**
+     * @brief  구독 큐에서 이벤트를 꺼냅니다.
+     * @param  timeout_ms 대기 시간 (음수: 무한 대기, 0: 즉시 리턴, 양수: 밀리초 대기)
+     */
+    std::optional<Device::Event> Device::Subscription::WaitMs( int timeout_ms )
+    {
+        if( channel_ == nullptr ) return std::nullopt;
+
+        Channel& ch = *channel_;
+
+        // 이전에 받은 FD_EVENT의 fd 감시 재개
+        GetPtr()->RearmFds( ch );
+
+        Event event;
+        if( ch.Pop( event ) ) return event;
+        if( timeout_ms == 0 ) return std::nullopt;
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds( timeout_ms );
+
+        std::unique_lock<std::mutex> lock( ch.wait_mtx );
+        ch.waiters.fetch_add( 1, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+
+        bool got = false;
+        while( !( got = ch.Pop( event ) ) )
+        {
+            if( timeout_ms < 0 ) {
+                ch.cv.wait( lock );
+            }
+            else if( ch.cv.wait_until( lock, deadline ) == std::cv_status::timeout ) {
+                got = ch.Pop( event );
+                break;
+            }
+        }
+
+        ch.waiters.fetch_sub( 1, std::memory_order_relaxed );
+
+        if( got ) return event;
+        return std::nullopt;
+    }
+
+    size_t Device::Subscription::DrainMs( std::span<Event> out, int timeout_ms )
+    {
+        if( out.empty() ) return 0;
+
+        // 첫 이벤트만 대기 (이후는 이미 쌓인 것만)
+        auto first = WaitMs( timeout_ms );
+        if( !first.has_value() ) return 0;
+
+        out[0] = std::move( *first );
+
+        size_t count = 1;
+        while( count < out.size() && channel_->Pop( out[count] ) ) {
+            count++;
+        }
+        return count;
+    }
+
     // =========================================================================
     // Public Static Implementation
     // =========================================================================
 
-    DeviceInputCode Device::GetInput( void )
+    Device::Subscription Device::Subscribe( size_t capacity, bool with_loop_events )
+    {
+        Device* instance = GetPtr();
+        auto    channel  = std::make_shared<Channel>( capacity, with_loop_events );
+
+        instance->AddChannel( channel );
+        instance->EnsureReaderThread();
+        return Subscription( std::move( channel ) );
+    }
+
+    void Device::SetCoalesce( uint8_t flags )
+    {
+        Device* instance = GetPtr();
+
+        instance->EnsureDefaultSub();
+        instance->default_sub_.SetCoalesce( flags );
+    }
+
+    Device::Event Device::GetInput( void )
     {
         // C++17 Style: 변수 선언과 조건 검사를 동시에 수행
         if( auto result = GetPtr()->GetInputMs( -1 ); result ){
             return *result;
         }
-        return DeviceInputCode::NONE;
+        return Event{ DeviceInputCode::NONE };
+    }
+
+    Device::Event Device::Inspect( const std::optional<Event>& opt_event )
+    {
+        // 값이 없으면 바로 NONE 반환
+        if( !opt_event.has_value() ){
+            return Event{ DeviceInputCode::NONE };
+        }
+        return opt_event.value();
     }
 
     Device::Event Device::Inspect( const std::optional<DeviceInputCode>& opt_key )
@@ -36,15 +291,12 @@ namespace cx
         }
 
         Event e {};
-        e.code = opt_key.value();
+        e.code      = opt_key.value();
+        e.timestamp = std::chrono::steady_clock::now();
 
         // 2. Enum 분기 처리는 switch가 가장 깔끔함
         switch( e.code )
         {
-            case DeviceInputCode::MOUSE_EVENT:
-                e.mouse = GetMouseState();
-                break;
-
             case DeviceInputCode::RESIZE_EVENT:
                 // case 구문 내부에서 변수를 만들어 사용한다면
                 // 반드시 scope 처리를 해 줘야 함.
@@ -54,10 +306,6 @@ namespace cx
                 }
                 break;
 
-            case DeviceInputCode::CURSOR_EVENT:
-                e.cursor = GetPtr()->last_cursor_pos_;
-                break;
-
             default:
                 // 일반 키 입력(A, B, ENTER 등)은 추가 데이터가 없으므로 아무것도 안 함
                 break;
@@ -70,15 +318,16 @@ namespace cx
     {
         Device* instance = GetPtr();
 
-        uint64_t u = EVENT_CODE_INTERRUPT;
-        ssize_t  s = write( instance->event_fd_, &u, sizeof(uint64_t) ); (void)(s);
-
-        instance->SetRawMode( false );
+        instance->Notify( EVENT_CODE_INTERRUPT );
+        instance->SetRawModeWithLock( false );
     }
 
     void Device::Resume( void )
     {
-        GetPtr()->SetRawModeWithLock( true );
+        Device* instance = GetPtr();
+
+        instance->SetRawModeWithLock( true );
+        instance->Notify( EVENT_CODE_WAKEUP ); // Reader 스레드가 STDIN 감시를 재개하도록
     }
 
     void Device::Deinit( void )
@@ -88,17 +337,158 @@ namespace cx
 
     MouseState Device::GetMouseState( void )
     {
-        return GetPtr()->last_mouse_state_;
+        return t_last_mouse;
     }
 
     void Device::EnableMouse( bool enable )
     {
         auto ptr = GetPtr();
 
+        // SGR 마우스 보고를 지원하지 않는 것으로 확인된 터미널 (구형 형식 좌표는 해석하지 않음)
+        auto caps = Capabilities::Current();
+        if( enable && caps->probed && !caps->sgr_mouse ) return;
+
         ptr->is_mouse_tracking_ = enable;
 
-        if( enable ){ std::cout << "\033[?1000h\033[?1002h\033[?1006h" << std::flush; }
-        else        { std::cout << "\033[?1000l\033[?1002l\033[?1006l" << std::flush; }
+        if( enable ){ Screen::Write( "\033[?1000h\033[?1002h\033[?1006h" ); }
+        else        { Screen::Write( "\033[?1000l\033[?1002l\033[?1006l" ); }
+    }
+
+    void Device::EnablePaste( bool enable )
+    {
+        auto ptr = GetPtr();
+
+        auto caps = Capabilities::Current();
+        if( enable && caps->probed && !caps->bracketed_paste ) return;
+
+        ptr->is_paste_enabled_ = enable;
+
+        if( enable ){ Screen::Write( "\033[?2004h" ); }
+        else        { Screen::Write( "\033[?2004l" ); }
+    }
+
+    void Device::EnableKittyKeyboard( bool enable, uint8_t flags )
+    {
+        auto ptr = GetPtr();
+
+        if( !enable ) {
+            if( ptr->kitty_requested_ ) Screen::Write( "\033[<u" );
+            ptr->kitty_requested_ = 0;
+            ptr->kitty_flags_     = 0;
+            return;
+        }
+
+        // 이미 확인된 터미널 특성상 지원하지 않으면 요청하지 않음
+        auto caps = Capabilities::Current();
+        if( caps->probed && !caps->kitty_keyboard ) return;
+
+        ptr->kitty_requested_ = flags;
+        Screen::Write( "\033[>" + std::to_string( flags ) + "u" );
+
+        // 지원 여부는 질의(CSI ? u) 응답이 오면 Reader 스레드에서 kitty_flags_에 반영
+        Query( TermQuery::KEYBOARD_FLAGS, [ptr, flags]( const QueryReply& reply ) {
+            if( !reply.ok || ptr->kitty_requested_.load() != flags ) return;
+            ptr->kitty_flags_ = static_cast<uint8_t>( reply.params[0] );
+
+            // 반영하는 사이에 끄거나 다시 요청했으면 되돌림 (늦게 온 응답이 꺼진 상태를 덮어쓰지 않도록)
+            if( ptr->kitty_requested_.load() != flags ) ptr->kitty_flags_ = 0;
+        } );
+    }
+
+    uint8_t Device::GetKeyboardFlags( void )
+    {
+        return GetPtr()->kitty_flags_.load();
+    }
+
+    /// @brief 첫 측정 전까지의 ESC 판별 대기 시간 (SSH 접속이면 네트워크 지연을 고려하여 길게)
+    static int DefaultEscTimeoutMs( int local_ms, int remote_ms )
+    {
+        bool is_remote = getenv( "SSH_CONNECTION" ) != nullptr || getenv( "SSH_TTY" ) != nullptr;
+        return is_remote ? remote_ms : local_ms;
+    }
+
+    void Device::SetEscTimeout( std::chrono::milliseconds timeout )
+    {
+        auto ptr = GetPtr();
+
+        int ms = static_cast<int>( std::clamp<int64_t>( timeout.count(), 0, ESC_TIMEOUT_MAX_MS ) );
+        ptr->esc_fixed_ms_   = ms;
+        ptr->esc_timeout_ms_ = ( ms > 0 ) ? ms : DefaultEscTimeoutMs( ESC_TIMEOUT_LOCAL_MS, ESC_TIMEOUT_REMOTE_MS ); // 자동: 다음 측정부터 조정
+    }
+
+    std::chrono::milliseconds Device::GetEscTimeout( void )
+    {
+        return std::chrono::milliseconds( GetPtr()->esc_timeout_ms_.load() );
+    }
+
+    void Device::SetFrameRate( int fps, FramePacing pacing )
+    {
+        Device* instance = GetPtr();
+        instance->EnsureReaderThread();
+
+        std::lock_guard<std::mutex> lock( instance->frame_mtx_ );
+
+        instance->frame_interval_ = ( fps > 0 )
+            ? std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::nanoseconds( 1000000000LL / fps ) )
+            : std::chrono::steady_clock::duration::zero();
+        instance->frame_pacing_ = pacing;
+
+        if( pacing == FramePacing::CONTINUOUS && fps > 0 ) {
+            instance->ArmFrameTimer( std::chrono::steady_clock::now() ); // 첫 틱은 즉시
+        }
+        else if( !instance->frame_asap_ && instance->frame_due_ == TimePoint::max() ) {
+            instance->ArmFrameTimer( TimePoint::max() ); // 남은 요청이 없으면 타이머 정지
+        }
+    }
+
+    /// @brief FdFlag 관심 목록 -> epoll 이벤트 마스크 (한 번 알린 뒤 재개 대기: EPOLLONESHOT)
+    static uint32_t ToEpollEvents( uint8_t interest )
+    {
+        uint32_t events = EPOLLONESHOT | EPOLLET;
+        if( interest & FD_READ  ) events |= EPOLLIN;
+        if( interest & FD_WRITE ) events |= EPOLLOUT;
+        return events;
+    }
+
+    void Device::WatchFd( int fd, uint8_t interest )
+    {
+        if( fd < 0 ) return;
+
+        Device* instance = GetPtr();
+
+        std::lock_guard<std::mutex> lock( instance->watch_mtx_ );
+        auto& fds = instance->watch_fds_;
+        auto  it  = std::find_if( fds.begin(), fds.end(), [fd]( const WatchedFd& w ) { return w.fd == fd; } );
+
+        struct epoll_event ev {};
+        ev.events  = ToEpollEvents( interest );
+        ev.data.fd = fd;
+
+        // 이미 등록된 fd면 관심 목록만 갱신 (감시도 재개됨)
+        // epoll_ctl()은 epoll_wait() 중인 Reader 스레드에도 즉시 반영되므로 깨울 필요 없음
+        if( it != fds.end() ) {
+            it->interest = interest;
+            epoll_ctl( instance->epoll_fd_, EPOLL_CTL_MOD, fd, &ev );
+            return;
+        }
+
+        if( epoll_ctl( instance->epoll_fd_, EPOLL_CTL_ADD, fd, &ev ) == 0 ) {
+            fds.push_back( { fd, interest } );
+        }
+    }
+
+    void Device::UnwatchFd( int fd )
+    {
+        Device* instance = GetPtr();
+
+        std::lock_guard<std::mutex> lock( instance->watch_mtx_ );
+        auto& fds = instance->watch_fds_;
+        auto  it  = std::find_if( fds.begin(), fds.end(), [fd]( const WatchedFd& w ) { return w.fd == fd; } );
+        if( it == fds.end() ) return;
+
+        // 호출 측이 곧바로 close() 해도 되도록, 닫히기 전에 epoll에서 제거
+        epoll_ctl( instance->epoll_fd_, EPOLL_CTL_DEL, fd, nullptr );
+        fds.erase( it );
     }
 
     int Device::KeyToInt( const DeviceInputCode key )
@@ -116,6 +506,10 @@ namespace cx
             case DeviceInputCode::RESIZE_EVENT: return "RESIZE_EVENT";
             case DeviceInputCode::MOUSE_EVENT:  return "MOUSE_EVENT";
             case DeviceInputCode::CURSOR_EVENT: return "CURSOR_EVENT";
+            case DeviceInputCode::FD_EVENT:     return "FD_EVENT";
+            case DeviceInputCode::FRAME_EVENT:  return "FRAME_EVENT";
+            case DeviceInputCode::PASTE_EVENT:  return "PASTE_EVENT";
+            case DeviceInputCode::TEXT_EVENT:   return "TEXT_EVENT";
 
             case DeviceInputCode::ENTER:        return "ENTER";
             case DeviceInputCode::ESC:          return "ESC";
@@ -161,30 +555,46 @@ namespace cx
         return &instance;
     }
 
+
     Device::Device()
         : event_fd_         ( -1      )
+        , epoll_fd_         ( -1      )
         , is_raw_mode_      ( false   )
+        , last_key_mods_    ( MOD_NONE )
+        , last_codepoint_   ( 0       )
+        , last_key_action_  ( KeyAction::PRESS )
         , is_mouse_tracking_( false   )
-        , is_input_running_ ( false   )
-        , cursor_promise_   ( nullptr )
+        , is_paste_enabled_ ( false   )
+        , in_paste_         ( false   )
+        , input_ring_       ( INPUT_RING_CAPACITY )
     {
-        input_buf_.reserve( 256 );
-
         memset( &old_sa_winch_, 0, sizeof(old_sa_winch_) );
         memset( &old_sa_int_,   0, sizeof(old_sa_int_)   );
 
+        esc_timeout_ms_ = DefaultEscTimeoutMs( ESC_TIMEOUT_LOCAL_MS, ESC_TIMEOUT_REMOTE_MS );
+
         Init();
     }
 
     Device::~Device()
     {
+        // Reader 스레드 종료 대기
+        if( reader_.joinable() ){
+            Notify( EVENT_CODE_STOP );
+            reader_.join();
+        }
+
         // rollback signal handle
         if( g_signal_event_fd != -1 ){ sigaction( SIGWINCH, &old_sa_winch_, nullptr ); }
         sigaction( SIGINT, &old_sa_int_, nullptr );
 
+        // 남은 화면 출력을 먼저 씀 (복구 시퀀스가 프레임 중간에 끼어들지 않도록)
+        Screen::DrainOutput( EXIT_DRAIN_TIMEOUT );
         ResetTerminalMode();
 
         if( event_fd_ != -1 ){ close( event_fd_ ); }
+        if( epoll_fd_ != -1 ){ close( epoll_fd_ ); }
+        if( frame_fd_ != -1 ){ close( frame_fd_ ); }
 
         g_signal_event_fd = -1;
     }
@@ -196,6 +606,16 @@ namespace cx
             write( STDOUT_FILENO, seq, strlen(seq) );
         }
 
+        if( is_paste_enabled_ ){
+            const char* seq = "\033[?2004l";
+            write( STDOUT_FILENO, seq, strlen(seq) );
+        }
+
+        if( kitty_requested_ ){
+            const char* seq = "\033[<u";
+            write( STDOUT_FILENO, seq, strlen(seq) );
+        }
+
         if( is_raw_mode_ ){
             tcsetattr( STDIN_FILENO, TCSANOW, &orig_termios_ );
             const char* seq = "\033[?25h";
@@ -207,7 +627,10 @@ namespace cx
     {
         if( sig == SIGWINCH && g_signal_event_fd != -1 )
         {
-            uint64_t val = EVENT_CODE_RESIZE;
+            // lock-free atomic 연산과 write()는 시그널 핸들러에서 안전함
+            g_pending_events.fetch_or( EVENT_CODE_RESIZE );
+
+            uint64_t val = 1;
             write( g_signal_event_fd, &val, sizeof(uint64_t) );
         }
         else if( sig == SIGINT || sig == SIGTERM )
@@ -229,6 +652,24 @@ namespace cx
         if( event_fd_ == -1 ) perror( "cx::Device eventfd creation failed" );
         g_signal_event_fd = event_fd_;
 
+        // Reader 스레드의 이벤트 루프 (STDIN은 Raw Mode 여부에 따라 Reader가 직접 등록/해제)
+        epoll_fd_ = epoll_create1( EPOLL_CLOEXEC );
+        if( epoll_fd_ == -1 ) perror( "cx::Device epoll creation failed" );
+
+        // eventfd는 read() 한 번으로 카운터가 0이 되므로 Edge-Triggered로 충분
+        struct epoll_event ev {};
+        ev.events  = EPOLLIN | EPOLLET;
+        ev.data.fd = event_fd_;
+        epoll_ctl( epoll_fd_, EPOLL_CTL_ADD, event_fd_, &ev );
+
+        // 프레임 스케줄러 타이머 (steady_clock과 같은 CLOCK_MONOTONIC 기준)
+        frame_fd_ = timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC );
+        if( frame_fd_ == -1 ) perror( "cx::Device timerfd creation failed" );
+
+        ev.events  = EPOLLIN | EPOLLET;
+        ev.data.fd = frame_fd_;
+        epoll_ctl( epoll_fd_, EPOLL_CTL_ADD, frame_fd_, &ev );
+
         struct sigaction sa;
         sa.sa_flags = 0;
         sigemptyset( &sa.sa_mask );
@@ -241,174 +682,627 @@ namespace cx
         SetRawModeWithLock( true );
     }
 
+    /**
+     * @brief Reader 스레드에 이벤트 비트를 전달하고 깨웁니다.
+     */
+    void Device::Notify( uint32_t bits )
+    {
+        g_pending_events.fetch_or( bits );
+
+        uint64_t u = 1;
+        ssize_t  s = write( event_fd_, &u, sizeof(uint64_t) ); (void)(s);
+    }
+
     // =========================================================================
     // Core Input Logic
     // =========================================================================
 
     /**
-     * @brief  지정된 시간(ms) 동안 입력을 대기하고 파싱합니다.
+     * @brief  기본 구독에서 입력을 꺼냅니다.
      * @param  timeout_ms 대기 시간 (음수: 무한 대기, 0: 즉시 리턴, 양수: 밀리초 대기)
-     * @return std::optional<DeviceInputCode> (입력 발생 시 코드 반환, 타임아웃 시 nullopt)
+     * @return std::optional<Event> (입력 발생 시 이벤트 반환, 타임아웃 시 nullopt)
      *
      * @details
-     *   1. Atomic Flag를 사용하여 한 번에 하나의 스레드만 입력 처리에 진입하도록 보장합니다.
-     *   2. 내부 버퍼(input_buf_)를 우선 검사하여 처리되지 않은 데이터가 있는지 확인합니다.
-     *   3. select() 시스템 콜을 사용하여 키보드 입력(STDIN)과 시스템 이벤트(EventFD)를 동시에 감시합니다.
+     *   실제 STDIN 읽기와 파싱은 Reader 스레드가 담당하므로,
+     *   여러 스레드가 동시에 호출해도 BUSY로 거절되지 않고 각자 대기합니다.
      */
-    std::optional<DeviceInputCode> Device::GetInputMs( const int timeout_ms )
+    std::optional<Device::Event> Device::GetInputMs( const int timeout_ms )
     {
-        // ---------------------------------------------------------------------
-        // 1. Thread Safety (The Gatekeeper)
-        // ---------------------------------------------------------------------
-        // 다른 스레드가 이미 GetInput을 실행 중인지 확인합니다.
-        // CAS(Compare-And-Swap) 연산을 통해 lock-free 방식으로 진입을 제어합니다.
-        bool expected = false;
-        if( !is_input_running_.compare_exchange_strong( expected, true ) ){
-            return DeviceInputCode::BUSY; // 이미 다른 스레드가 점유 중임
-        }
-
-        // RAII Pattern
-        // 함수가 종료(return)되거나 예외가 발생하면
-        // 자동으로 소멸자에서 is_input_running_ 플래그를
-        // false로 해제합니다. (Deadlock 방지)
-        struct BusyGuard {
-            std::atomic<bool>& flag;
-            ~BusyGuard(){ flag.store( false ); }
-        } guard{ is_input_running_ };
-
-        // ---------------------------------------------------------------------
-        // 2. Ensure Raw Mode
-        // ---------------------------------------------------------------------
         // 입력 처리를 위해서는 터미널이 Raw Mode(엔터 없이 입력, 에코 끔)여야 합니다.
-        if( !is_raw_mode_ ){
-            std::lock_guard<std::mutex> lock( mtx_ );
-            if( !is_raw_mode_ ) SetRawMode( true );
-        }
+        EnsureRawMode();
 
-        using namespace std::chrono;
-        auto start_time = steady_clock::now();
+        EnsureDefaultSub();
 
-        // ---------------------------------------------------------------------
-        // 3. Main Loop (Parse -> Select -> Read)
-        // ---------------------------------------------------------------------
-        while( true )
-        {
-            // A. 버퍼 처리 (Parsing)
-            // 이전에 읽어둔 데이터(input_buf_)가 남아있다면 먼저 처리합니다.
-            while( !input_buf_.empty() )
-            {
-                auto [ key, consumed_len ] = ParseInputBuffer( input_buf_ );
+        auto event = default_sub_.WaitMs( timeout_ms );
+        if( !event.has_value() ) return std::nullopt;
 
-                // consumed_len == 0 은 "데이터가 부족하여 파싱 불가(Incomplete)"를 의미
-                // 더 많은 데이터를 읽기 위해 select 단계로 이동
-                if( consumed_len == 0 ) break;
+        if( event->code == DeviceInputCode::MOUSE_EVENT ) t_last_mouse = event->mouse;
+        return event;
+    }
 
-                // 파싱 성공: 처리한 만큼 버퍼에서 제거
-                input_buf_.erase( 0, consumed_len );
+    size_t Device::GetEventsMs( std::span<Event> out, const int timeout_ms )
+    {
+        EnsureRawMode();
+        EnsureDefaultSub();
 
-                // [Intercept Logic]
-                // 커서 위치 응답(CURSOR_EVENT) 가로채기
-                // 일반 사용자에게 전달하지 않고, GetCursorPos()를 호출해 대기 중인 스레드에게 전달
-                if( key == DeviceInputCode::CURSOR_EVENT )
-                {
-                    std::lock_guard<std::mutex> lock( cursor_promise_mtx_ );
-                    if( cursor_promise_ != nullptr )
-                    {
-                        // 값 전달; 약속 이행 완료
-                        cursor_promise_->set_value( last_cursor_pos_ );
-                        cursor_promise_ = nullptr;
-
-                        // 사용자에겐 알리지 않고 다음 입력 처리
-                        continue;
-                    }
-                    // scope 벗어나며 lock_guard 해제
-                }
+        size_t count = default_sub_.DrainMs( out, timeout_ms );
 
-                // 일반 키 입력이면 즉시 반환
-                if( key != DeviceInputCode::NONE ) return key;
+        // GetMouseState() 호환: 묶음 중 마지막 마우스 상태를 기록
+        for( size_t i = count; i > 0; --i ) {
+            if( out[i - 1].code == DeviceInputCode::MOUSE_EVENT ) {
+                t_last_mouse = out[i - 1].mouse;
+                break;
             }
+        }
+        return count;
+    }
 
-            // B. 남은 시간 계산 (Timeout Calculation)
-            int current_timeout = -1;
-            if( timeout_ms >= 0 )
-            {
-                auto elapsed    = duration_cast<milliseconds>( steady_clock::now() - start_time );
-                current_timeout = timeout_ms - (int)elapsed.count();
+    void Device::EnsureRawMode( void )
+    {
+        if( is_raw_mode_ ) return;
 
-                // 시간 초과 시 std::optional의 std::nullopt 반환
-                if( current_timeout <= 0 )
-                    return std::nullopt;
-            }
+        {
+            std::lock_guard<std::mutex> lock( mtx_ );
+            if( is_raw_mode_ ) return;
+            SetRawMode( true );
+        }
+        Notify( EVENT_CODE_WAKEUP ); // Reader 스레드가 STDIN 감시를 재개하도록
+    }
 
-            // C. I/O Multiplexing (select)
-            fd_set readfds;
-            FD_ZERO( &readfds );
-            FD_SET( STDIN_FILENO, &readfds ); // 키보드 입력 감시
-            FD_SET( event_fd_, &readfds );    // 시그널/강제종료 감시
-            int max_fd = std::max( STDIN_FILENO, event_fd_ );
+    /**
+     * @brief Reader 스레드를 (최초 1회) 시작합니다.
+     */
+    void Device::EnsureReaderThread( void )
+    {
+        std::call_once( reader_once_, [this]() {
+            reader_ = std::thread( &Device::ReaderLoop, this );
+        } );
+    }
 
-            struct timeval  tv;
-            struct timeval* ptv = nullptr;
-            if( current_timeout >= 0 )
-            {
-                tv.tv_sec  = ( current_timeout / 1000 );
-                tv.tv_usec = ( current_timeout % 1000 ) * 1000;
-                ptv = &tv;
-            }
+    /**
+     * @brief GetInput()용 기본 구독을 (처음 GetInput() 호출 시) 만듭니다.
+     * @note  Subscribe()만 쓰는 앱에서는 만들지 않으므로, 아무도 꺼내지 않는 큐에 이벤트가 쌓이지 않습니다.
+     */
+    void Device::EnsureDefaultSub( void )
+    {
+        std::call_once( default_once_, [this]() {
+            auto channel = std::make_shared<Channel>( DEFAULT_QUEUE_CAPACITY, true );
+            AddChannel( channel );
+            default_sub_ = Subscription( std::move( channel ) );
+        } );
 
-            // 커널에게 "데이터가 들어올 때까지" 혹은 "타임아웃까지" 대기 요청
-            int activity = select( max_fd + 1, &readfds, nullptr, nullptr, ptv );
+        EnsureReaderThread();
+    }
 
-            // 시스템 에러
-            if( activity < 0 && errno != EINTR )
-                return std::nullopt;
+    void Device::AddChannel( const std::shared_ptr<Channel>& channel )
+    {
+        std::lock_guard<std::mutex> lock( subs_mtx_ );
 
-            // 타임아웃 발생 [ESC 지연 해결 패치]
-            if( activity == 0 )
-            {
-                // 버퍼에 ESC(27) 하나만 남아있고 타임아웃이 발생했다면,
-                // 이는 시퀀스(화살표 키 등)를 기다리는 중이 아니라 단독 ESC 키 입력입니다.
-                if( input_buf_.length() == 1 && input_buf_[0] == 27 )
-                {
-                    input_buf_.clear();
-                    return DeviceInputCode::ESC;
-                }
+        auto next = std::make_shared<ChannelList>();
+        if( auto current = std::atomic_load( &channels_ ) ) *next = *current;
+        next->push_back( channel );
 
-                return std::nullopt;
-            }
+        std::atomic_store( &channels_, std::shared_ptr<const ChannelList>( std::move( next ) ) );
+    }
 
-            // D. Read Data
-            bool data_read = false;
+    void Device::Unsubscribe( const std::shared_ptr<Channel>& channel )
+    {
+        std::lock_guard<std::mutex> lock( subs_mtx_ );
 
-            // D-1. 시스템 이벤트 (EventFD)
-            if( FD_ISSET( event_fd_, &readfds ) )
-            {
-                uint64_t u = 0;
-                read( event_fd_, &u, sizeof(uint64_t) );
+        auto current = std::atomic_load( &channels_ );
+        if( !current ) return;
 
-                if( u == EVENT_CODE_INTERRUPT ) return DeviceInputCode::INTERRUPT;
-                if( u == EVENT_CODE_RESIZE    ) return DeviceInputCode::RESIZE_EVENT;
+        auto next = std::make_shared<ChannelList>( *current );
+        next->erase( std::remove( next->begin(), next->end(), channel ), next->end() );
 
-                data_read = true;
-            }
+        std::atomic_store( &channels_, std::shared_ptr<const ChannelList>( std::move( next ) ) );
+    }
 
-            // D-2. 키보드/마우스 입력 (STDIN)
-            if( FD_ISSET( STDIN_FILENO, &readfds ) )
-            {
-                char temp_buf[256];
-                ssize_t len = read( STDIN_FILENO, temp_buf, sizeof(temp_buf) );
+    // =========================================================================
+    // Frame Scheduler
+    // =========================================================================
 
-                if( len > 0 )
-                {
-                    input_buf_.append( temp_buf, len ); // 버퍼 뒤에 이어 붙이기
-                    data_read = true;
-                }
-            }
+    /**
+     * @brief  FRAME_EVENT를 요청합니다.
+     * @param  due 지연 요청 시각 (time_point{}: 다음 렌더링 시점에 즉시)
+     */
+    void Device::RequestFrameAt( TimePoint due )
+    {
+        EnsureReaderThread();
 
-            // 데이터를 읽었다면 루프의 처음(A. 버퍼 처리)으로 돌아가 파싱 시도
-            if( data_read )
-                continue;
-        }
+        std::lock_guard<std::mutex> lock( frame_mtx_ );
+
+        // 고정 FPS로 계속 틱이 발생하고 있으므로 요청할 필요 없음
+        if( frame_pacing_ == FramePacing::CONTINUOUS && frame_interval_.count() > 0 ) return;
+
+        if( due == TimePoint{} ) frame_asap_ = true;
+        else                     frame_due_  = std::min( frame_due_, due );
+
+        // 프레임 간격(1/fps) 유지: 직전 프레임 직후라면 다음 슬롯까지 미룸
+        TimePoint target = frame_asap_ ? std::chrono::steady_clock::now() : frame_due_;
+        if( frame_interval_.count() > 0 ) target = std::max( target, last_frame_ + frame_interval_ );
+
+        if( target < frame_armed_at_ ) ArmFrameTimer( target );
+    }
+
+    /**
+     * @brief timerfd를 절대 시각 at에 만료되도록 설정합니다. (frame_mtx_ 보유 상태에서 호출)
+     * @note  at == max 이면 타이머를 끕니다. 이미 지난 시각이면 즉시 만료됩니다.
+     */
+    void Device::ArmFrameTimer( TimePoint at )
+    {
+        frame_armed_at_ = at;
+
+        struct itimerspec spec {};
+        if( at != TimePoint::max() ) {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>( at.time_since_epoch() ).count();
+            if( ns <= 0 ) ns = 1; // it_value가 0이면 타이머가 꺼지므로 최소값 보정
+            spec.it_value.tv_sec  = ns / 1000000000LL;
+            spec.it_value.tv_nsec = ns % 1000000000LL;
+        }
+        timerfd_settime( frame_fd_, TFD_TIMER_ABSTIME, &spec, nullptr );
+    }
+
+    /**
+     * @brief 타이머 만료 처리 (Reader 스레드)
+     *
+     * @details
+     *   - 만료 시점에 요청이 있으면(또는 CONTINUOUS이면) FRAME_EVENT를 배포합니다.
+     *   - 이전 FRAME_EVENT를 아직 꺼내지 않은 구독자에게는 새로 쌓지 않습니다. (구독자별로 판단)
+     *     그 프레임이 꺼내지는 시점의 최신 상태를 그리므로, 요청은 그 프레임에 합쳐집니다.
+     *   - 다음 만료 시각을 다시 설정합니다. (CONTINUOUS: 고정 격자, ON_DEMAND: 남은 지연 요청)
+     */
+    void Device::OnFrameTimer( void )
+    {
+        uint64_t expirations = 0;
+        if( read( frame_fd_, &expirations, sizeof(expirations) ) != sizeof(expirations) ) return; // 재설정되어 만료가 취소됨
+
+        Event e { DeviceInputCode::FRAME_EVENT };
+        {
+            std::lock_guard<std::mutex> lock( frame_mtx_ );
+
+            auto now        = std::chrono::steady_clock::now();
+            bool continuous = frame_pacing_ == FramePacing::CONTINUOUS && frame_interval_.count() > 0;
+            bool due_passed = frame_due_ <= now;
+            bool is_due     = continuous || frame_asap_ || due_passed;
+
+            // 다음 만료 시각 설정
+            if( continuous ) {
+                // 격자를 유지하며, 밀린 틱은 따라잡지 않고 건너뜀
+                TimePoint next = frame_armed_at_ + frame_interval_;
+                if( next <= now ) {
+                    auto behind = ( now - frame_armed_at_ ) / frame_interval_;
+                    frame_skipped_ += static_cast<uint32_t>( behind );
+                    next = frame_armed_at_ + ( behind + 1 ) * frame_interval_;
+                }
+                ArmFrameTimer( next );
+            }
+            else {
+                if( is_due ) {
+                    frame_asap_ = false;
+                    if( due_passed ) frame_due_ = TimePoint::max();
+                }
+
+                TimePoint next = frame_due_;
+                if( frame_asap_ ) next = now; // 만료 직전에 들어온 요청
+                if( next != TimePoint::max() && frame_interval_.count() > 0 ) {
+                    next = std::max( next, now + frame_interval_ );
+                }
+                ArmFrameTimer( next );
+            }
+
+            if( !is_due ) return;
+
+            // 받을 수 있는 구독자가 모두 이전 프레임을 아직 꺼내지 않았으면 건너뜀
+            auto channels = std::atomic_load( &channels_ );
+            bool has_loop = false, has_ready = false;
+            if( channels ) {
+                for( const auto& ch : *channels ) {
+                    if( !ch->wants_loop_events ) continue;
+                    has_loop = true;
+                    if( !ch->frame_pending.load( std::memory_order_acquire ) ) has_ready = true;
+                }
+            }
+            if( !has_ready ) {
+                if( continuous && has_loop ) frame_skipped_++;
+                return;
+            }
+
+            last_frame_ = now;
+
+            e.frame         = ++frame_count_;
+            e.frame_skipped = frame_skipped_;
+            e.timestamp     = now;
+            frame_skipped_  = 0;
+        }
+
+        // 큐가 가득 차서 못 받은 구독자가 있으면, ON_DEMAND는 요청이 사라지지 않도록 잠시 뒤 다시 전달
+        // (이미 받은 구독자는 frame_pending이므로 중복으로 쌓이지 않음)
+        if( !PublishFrame( e ) ) {
+            constexpr auto RETRY_DELAY = std::chrono::milliseconds( 10 );
+
+            std::lock_guard<std::mutex> lock( frame_mtx_ );
+
+            bool continuous = frame_pacing_ == FramePacing::CONTINUOUS && frame_interval_.count() > 0;
+            if( !continuous ) {
+                frame_due_ = std::min( frame_due_, e.timestamp + RETRY_DELAY );
+                if( frame_due_ < frame_armed_at_ ) ArmFrameTimer( frame_due_ );
+            }
+        }
+    }
+
+    /**
+     * @brief  FRAME_EVENT를 이전 프레임을 꺼낸 구독자에게만 전달합니다.
+     * @return 큐가 가득 차서 버려진 구독자가 없으면 true
+     */
+    bool Device::PublishFrame( const Event& event )
+    {
+        auto channels = std::atomic_load( &channels_ );
+        if( !channels ) return true;
+
+        bool all_accepted = true;
+        for( const auto& ch : *channels ) {
+            if( !ch->wants_loop_events ) continue;
+            if( ch->frame_pending.exchange( true, std::memory_order_acq_rel ) ) continue;
+
+            // 버려졌으면 꺼낼 프레임이 없으므로 되돌림 (그대로 두면 이 구독자에게 이후 틱이 모두 막힘)
+            if( !ch->Push( event ) ) {
+                ch->frame_pending.store( false, std::memory_order_release );
+                all_accepted = false;
+            }
+        }
+        return all_accepted;
+    }
+
+    /**
+     * @brief 구독자가 받아 간 FD_EVENT의 fd를 다시 감시 대상으로 돌립니다.
+     *
+     * @details
+     *   사용자 fd는 EPOLLONESHOT으로 등록되어, 한 번 FD_EVENT를 보내면 감시가 멈춥니다.
+     *   그렇지 않으면 소비자가 read() 하기 전까지 같은 이벤트가 계속 쏟아집니다.
+     *   EPOLL_CTL_MOD로 재등록하면 그 시점에 아직 읽을 데이터가 남아 있을 경우 곧바로 다시 알려 줍니다.
+     */
+    void Device::RearmFds( Channel& channel )
+    {
+        std::vector<int> fds;
+        {
+            std::lock_guard<std::mutex> lock( channel.rearm_mtx );
+            if( channel.rearm_fds.empty() ) return;
+            fds.swap( channel.rearm_fds );
+        }
+
+        std::lock_guard<std::mutex> lock( watch_mtx_ );
+        for( const auto& w : watch_fds_ ) {
+            if( std::find( fds.begin(), fds.end(), w.fd ) == fds.end() ) continue;
+
+            struct epoll_event ev {};
+            ev.events  = ToEpollEvents( w.interest );
+            ev.data.fd = w.fd;
+            epoll_ctl( epoll_fd_, EPOLL_CTL_MOD, w.fd, &ev );
+        }
+    }
+
+    /**
+     * @brief 파싱된 이벤트를 모든 구독자 큐에 전달합니다.
+     */
+    void Device::Publish( Event event )
+    {
+        auto channels = std::atomic_load( &channels_ );
+        if( !channels ) return;
+
+        if( event.timestamp == std::chrono::steady_clock::time_point{} ) {
+            event.timestamp = std::chrono::steady_clock::now();
+        }
+
+        for( const auto& ch : *channels ) {
+            if( event.code == DeviceInputCode::FD_EVENT && !ch->wants_loop_events ) continue;
+            ch->Push( event );
+        }
+    }
+
+    /**
+     * @brief input_ring_에 쌓인 데이터를 가능한 만큼 파싱하여 배포합니다.
+     * @note  버퍼를 복사하거나 앞에서 지우지 않고, 파싱 위치만 앞으로 옮깁니다.
+     */
+    void Device::ParseAndPublish( void )
+    {
+        while( !input_ring_.Empty() )
+        {
+            std::string_view view = input_ring_.Peek();
+
+            // [Bracketed Paste] 끝 표시가 나올 때까지 본문을 그대로 모음 (키 파싱 안 함)
+            if( in_paste_ )
+            {
+                size_t end = view.find( PASTE_END );
+                if( end == std::string_view::npos ) {
+                    // 끝 표시가 잘려서 도착했을 수 있으므로, 그 길이만큼은 다음 수신까지 남겨 둠
+                    size_t take = view.size() - std::min( view.size(), PASTE_END.size() - 1 );
+                    paste_buf_.append( view.substr( 0, take ) );
+                    input_ring_.Consume( take );
+                    break;
+                }
+
+                paste_buf_.append( view.substr( 0, end ) );
+                input_ring_.Consume( end + PASTE_END.size() );
+                in_paste_ = false;
+
+                Event e { DeviceInputCode::PASTE_EVENT };
+                e.timestamp = input_time_;
+                e.paste     = std::make_shared<const std::string>( std::move( paste_buf_ ) );
+                paste_buf_.clear();
+
+                Publish( std::move( e ) );
+                continue;
+            }
+
+            if( view.starts_with( PASTE_BEGIN ) ) {
+                in_paste_ = true;
+                input_ring_.Consume( PASTE_BEGIN.size() );
+                continue;
+            }
+            if( view.starts_with( PASTE_END ) ) { // 짝이 없는 끝 표시는 무시
+                input_ring_.Consume( PASTE_END.size() );
+                continue;
+            }
+
+            // 파서가 채우는 키 부가 정보 (Alt 접두 처리 시 재귀 호출에서 누적됨)
+            last_key_mods_   = MOD_NONE;
+            last_codepoint_  = 0;
+            last_key_action_ = KeyAction::PRESS;
+
+            auto [ key, consumed_len ] = ParseInputBuffer( view );
+
+            // consumed_len == 0 은 "데이터가 부족하여 파싱 불가(Incomplete)"를 의미
+            if( consumed_len == 0 ) {
+                // 버퍼가 가득 찼는데도 끝나지 않는 시퀀스는 깨진 입력이므로 한 바이트 버림
+                if( !input_ring_.Full() ) break;
+                consumed_len = 1;
+                key          = DeviceInputCode::NONE;
+            }
+
+            // 파싱 성공: 처리한 만큼 파싱 위치 이동
+            input_ring_.Consume( consumed_len );
+
+            if( key == DeviceInputCode::NONE ) continue;
+
+            // [Intercept Logic]
+            // 커서 위치 응답(CURSOR_EVENT) 가로채기
+            // 일반 구독자에게 전달하지 않고, Query( CURSOR_POS )로 기다리는 쪽에 전달
+            // (대기 중인 질의가 없으면 앱이 직접 보낸 요청의 응답이므로 그대로 배포)
+            if( key == DeviceInputCode::CURSOR_EVENT )
+            {
+                QueryReply reply;
+                reply.query  = TermQuery::CURSOR_POS;
+                reply.cursor = last_cursor_pos_;
+                if( CompleteQuery( std::move( reply ) ) ) continue;
+            }
+
+            // 파서가 채운 상세 데이터를 이벤트에 복사 (이후 파싱에 덮어써지지 않음)
+            Event e {};
+            e.code      = key;
+            e.timestamp = input_time_;
+            e.mods      = last_key_mods_;
+            e.codepoint = last_codepoint_;
+            e.key_action = last_key_action_;
+            if( key == DeviceInputCode::MOUSE_EVENT  ) e.mouse  = last_mouse_state_;
+            if( key == DeviceInputCode::CURSOR_EVENT ) e.cursor = last_cursor_pos_;
+
+            Publish( e );
+        }
+    }
+
+    /**
+     * @brief Reader 스레드 본체
+     *
+     * @details
+     *   1. epoll로 키보드 입력(STDIN), 시스템 이벤트(EventFD), 프레임 타이머(timerfd), 사용자 등록 fd를 동시에 감시합니다.
+     *      감시 목록은 epoll에 한 번만 등록하므로, 매 반복마다 fd 집합을 다시 만들지 않습니다.
+     *   2. STDIN은 수신 버퍼(input_ring_)에 직접 읽어 들인 뒤, 파싱하여 구독자 큐에 배포합니다.
+     *   3. Raw Mode가 아닐 때(ForcePause)는 STDIN을 epoll에서 빼서, 앱이 std::cin 등을 쓸 수 있게 둡니다.
+     *
+     * @note
+     *   STDIN은 Level-Triggered로 감시합니다. Edge-Triggered는 EAGAIN까지 읽어야 하는데,
+     *   STDIN에 O_NONBLOCK을 걸면 같은 터미널을 공유하는 부모 셸까지 넌블로킹이 되기 때문입니다.
+     */
+    void Device::ReaderLoop( void )
+    {
+        constexpr int MAX_EVENTS = 32;
+        struct epoll_event events[MAX_EVENTS];
+
+        bool stdin_registered = false;
+        bool stdin_eof        = false;
+
+        while( true )
+        {
+            // 키보드 입력 감시 (Raw Mode일 때만)
+            bool want_stdin = is_raw_mode_ && !stdin_eof;
+            if( want_stdin != stdin_registered )
+            {
+                struct epoll_event ev {};
+                ev.events  = EPOLLIN;
+                ev.data.fd = STDIN_FILENO;
+                epoll_ctl( epoll_fd_, want_stdin ? EPOLL_CTL_ADD : EPOLL_CTL_DEL, STDIN_FILENO, &ev );
+                stdin_registered = want_stdin;
+            }
+
+            // 미완성 시퀀스가 남아 있으면 ESC 판별 시간만큼만 대기
+            // (붙여넣기 수신 중에는 남은 바이트가 ESC 키가 아니라 끝 표시의 일부이므로 계속 대기)
+            // (kitty 키보드 프로토콜이 켜져 있으면 ESC 키는 CSI 27 u로 오므로, ESC로 시작하면 항상 시퀀스)
+            // (질의 응답 문자열(DCS, OSC)을 받는 중이면 질의 제한 시간까지 대기)
+            bool no_esc_key = in_paste_ || kitty_flags_.load( std::memory_order_relaxed ) != 0 ||
+                              IsAwaitingStringReply( input_ring_.Peek() );
+
+            TimePoint wake_at = NextQueryDeadline();
+            if( !input_ring_.Empty() && !no_esc_key ) {
+                wake_at = std::min( wake_at, input_time_ + std::chrono::milliseconds( esc_timeout_ms_.load( std::memory_order_relaxed ) ) );
+            }
+
+            int timeout = -1;
+            if( wake_at != TimePoint::max() ) {
+                auto remain = std::chrono::ceil<std::chrono::milliseconds>( wake_at - std::chrono::steady_clock::now() ).count();
+                timeout = static_cast<int>( std::clamp<int64_t>( remain, 0, INT32_MAX ) );
+            }
+
+            int count = epoll_wait( epoll_fd_, events, MAX_EVENTS, timeout );
+
+            if( count < 0 ) {
+                if( errno == EINTR ) continue;
+                break; // 복구 불가능한 시스템 에러
+            }
+
+            // 제한 시간이 지난 질의는 실패로 완료 (ok == false)
+            ExpireQueries( std::chrono::steady_clock::now() );
+
+            // 타임아웃 발생 [ESC 지연 해결 패치]
+            if( count == 0 )
+            {
+                // 질의 제한 시간으로 깨어났을 수 있으므로, ESC 판별 시간이 실제로 지났는지 확인
+                bool esc_expired = !input_ring_.Empty() && !IsAwaitingStringReply( input_ring_.Peek() ) &&
+                                   std::chrono::steady_clock::now() >= input_time_ + std::chrono::milliseconds( esc_timeout_ms_.load() );
+                if( !esc_expired || in_paste_ || kitty_flags_.load( std::memory_order_relaxed ) != 0 ) continue;
+
+                // 시퀀스가 이어지지 않았으므로, 맨 앞의 ESC는 단독 ESC 키 입력입니다.
+                if( input_ring_.Peek()[0] == 27 ) {
+                    // 추측이 틀렸는지(나머지가 뒤늦게 오는지) 다음 수신에서 확인
+                    esc_guessed_    = true;
+                    esc_guess_time_ = input_time_;
+
+                    input_ring_.Consume( 1 );
+                    Event e { DeviceInputCode::ESC };
+                    e.timestamp = input_time_;
+                    Publish( e );
+                }
+                else {
+                    input_ring_.Clear();
+                }
+                ParseAndPublish();
+                continue;
+            }
+
+            // 처리 순서: 시스템 이벤트 -> 키보드 -> 프레임 -> 사용자 fd
+            // (같은 시점에 들어온 키 입력이 FRAME_EVENT, FD_EVENT보다 먼저 전달됨)
+            bool has_signal = false;
+            bool has_stdin  = false;
+            bool has_frame  = false;
+            for( int i = 0; i < count; ++i ) {
+                if( events[i].data.fd == event_fd_    ) has_signal = true;
+                if( events[i].data.fd == STDIN_FILENO ) has_stdin  = true;
+                if( events[i].data.fd == frame_fd_    ) has_frame  = true;
+            }
+
+            // A. 시스템 이벤트 (EventFD)
+            if( has_signal )
+            {
+                uint64_t u = 0;
+                ssize_t  s = read( event_fd_, &u, sizeof(uint64_t) ); (void)(s);
+
+                uint32_t bits = g_pending_events.exchange( 0 );
+
+                if( bits & EVENT_CODE_STOP ) break;
+                if( bits & EVENT_CODE_INTERRUPT ) Publish( Event{ DeviceInputCode::INTERRUPT } );
+                if( bits & EVENT_CODE_RESIZE ) {
+                    Event e { DeviceInputCode::RESIZE_EVENT };
+                    e.term_size = Screen::GetSize();
+                    Publish( e );
+                }
+            }
+
+            // B. 키보드/마우스 입력 (STDIN)
+            if( has_stdin && is_raw_mode_ )
+            {
+                // 드래그/붙여넣기처럼 몰려 들어오는 입력을 한 번의 read()로 받아 한꺼번에 파싱
+                // (수신 버퍼의 빈 공간에 직접 읽으므로 중간 복사 없음)
+                auto    space = input_ring_.WritableSpan();
+                ssize_t len   = read( STDIN_FILENO, space.data(), space.size() );
+
+                if( len > 0 ) {
+                    OnInputReceived( std::string_view( space.data(), static_cast<size_t>( len ) ) );
+                    input_time_ = std::chrono::steady_clock::now();
+                    input_ring_.Commit( static_cast<size_t>( len ) );
+                    ParseAndPublish();
+                }
+                else if( len == 0 ) {
+                    stdin_eof = true; // 입력 스트림 종료 (계속 감시하면 epoll이 매번 깨어남)
+                }
+            }
+
+            // C. 프레임 스케줄러 (timerfd)
+            if( has_frame ) OnFrameTimer();
+
+            // D. 사용자 등록 fd (EPOLLONESHOT: 구독자가 다음 대기를 시작할 때 재개)
+            for( int i = 0; i < count; ++i )
+            {
+                int fd = events[i].data.fd;
+                if( fd == event_fd_ || fd == STDIN_FILENO || fd == frame_fd_ ) continue;
+
+                uint32_t ready = events[i].events;
+
+                Event e { DeviceInputCode::FD_EVENT };
+                e.fd       = fd;
+                e.fd_ready = static_cast<uint8_t>(
+                    ( ( ready & EPOLLIN  ) ? FD_READ   : 0 ) |
+                    ( ( ready & EPOLLOUT ) ? FD_WRITE  : 0 ) |
+                    ( ( ready & EPOLLHUP ) ? FD_HANGUP : 0 ) |
+                    ( ( ready & EPOLLERR ) ? FD_ERROR  : 0 ) );
+                Publish( e );
+            }
+        }
+    }
+
+    /**
+     * @brief 새로 읽은 데이터로 ESC 판별 대기 시간을 측정합니다. (input_time_ 갱신 전에 호출)
+     *
+     * @details
+     *   측정 표본은 "시퀀스가 끊겨 도착한 간격"입니다.
+     *   1. 미완성 시퀀스가 남아 있는데 나머지가 도착함 : 대기 시간 안에 이어진 경우
+     *   2. 타임아웃으로 ESC를 확정했는데 시퀀스의 나머지가 뒤늦게 도착함 : 대기 시간이 너무 짧았던 경우
+     *      (사람이 ESC 다음에 '['나 'O'를 누른 경우와 구분하기 위해, 완성된 시퀀스 꼴일 때만 인정)
+     */
+    void Device::OnInputReceived( std::string_view data )
+    {
+        auto now = std::chrono::steady_clock::now();
+        auto ms  = [&]( std::chrono::steady_clock::time_point since ) {
+            return std::chrono::duration<double, std::milli>( now - since ).count();
+        };
+
+        if( !in_paste_ && !input_ring_.Empty() && input_ring_.Peek()[0] == 27 ) {
+            AddEscLatencySample( ms( input_time_ ) );
+        }
+        else if( esc_guessed_ && input_ring_.Empty() && data.size() >= 2 )
+        {
+            bool is_tail = false;
+            if( data[0] == '[' ) {
+                for( size_t i = 1; i < data.size() && !is_tail; ++i )
+                    is_tail = ( data[i] >= 0x40 && data[i] <= 0x7E );
+            }
+            else if( data[0] == 'O' ) {
+                char seq[3] = { '\033', 'O', data[1] };
+                is_tail = KEY_TRIE.Find( std::string_view( seq, 3 ) ).result == decltype( KEY_TRIE )::Result::MATCH;
+            }
+
+            double gap = ms( esc_guess_time_ );
+            if( is_tail && gap < ESC_TIMEOUT_MAX_MS ) AddEscLatencySample( gap );
+        }
+
+        esc_guessed_ = false;
+    }
+
+    void Device::AddEscLatencySample( double sample_ms )
+    {
+        if( !esc_has_sample_ ) {
+            esc_srtt_ms_    = sample_ms;
+            esc_rttvar_ms_  = sample_ms / 2.0;
+            esc_has_sample_ = true;
+        }
+        else {
+            esc_rttvar_ms_ = 0.75  * esc_rttvar_ms_ + 0.25  * std::fabs( esc_srtt_ms_ - sample_ms );
+            esc_srtt_ms_   = 0.875 * esc_srtt_ms_   + 0.125 * sample_ms;
+        }
+
+        if( esc_fixed_ms_.load( std::memory_order_relaxed ) > 0 ) return;
+
+        int estimate = static_cast<int>( std::ceil( esc_srtt_ms_ + 4.0 * esc_rttvar_ms_ ) );
+        esc_timeout_ms_ = std::clamp( estimate, ESC_TIMEOUT_MIN_MS, ESC_TIMEOUT_MAX_MS );
     }
 
     void Device::SetRawModeWithLock( const bool enable )
@@ -449,8 +1343,7 @@ namespace cx
             tcsetattr( STDIN_FILENO, TCSANOW, &raw );
 
             // 커서 숨기기 (\033[?25l) - UI 깔끔함을 위해
-            const char* seq = "\033[?25l";
-            write( STDOUT_FILENO, seq, strlen(seq) );
+            Screen::Write( "\033[?25l" );
 
             is_raw_mode_ = true;
         }
@@ -460,95 +1353,199 @@ namespace cx
             tcsetattr( STDIN_FILENO, TCSANOW, &orig_termios_ );
 
             // 커서 다시 보이기 (\033[?25h)
-            const char* seq = "\033[?25h";
-            write( STDOUT_FILENO, seq, strlen(seq) );
+            Screen::Write( "\033[?25h" );
 
             is_raw_mode_ = false;
         }
     }
 
-    void Device::RequestCursorPos( void )
-    {
-        std::cout << "\033[6n" << std::flush;
-    }
+    // =========================================================================
+    // Terminal Queries
+    // =========================================================================
 
     /**
-     * @brief 커서 위치 요청 시퀀스를 보내고 응답을 기다립니다.
+     * @brief 질의를 등록한 뒤 요청 시퀀스를 보냅니다.
      *
      * @details
-     *   커서 위치를 얻으려면 터미널에 '\033[6n'을 쓰고, STDIN으로 들어오는 '\033[row;colR'을 읽어야 합니다.
-     *
-     *   1. Observer Mode:
-     *      이미 다른 스레드(Main Loop)가 GetInput()으로 STDIN을 점유 중이라면,
-     *      Promise/Future를 통해 그 스레드에게 "응답 오면 나한테 줘"라고 부탁하고 대기합니다.
-     *
-     *   2. Direct Mode:
-     *      아무도 STDIN을 안 쓰고 있다면, 직접 GetInput()을 호출하여 응답을 읽어옵니다.
+     *   응답은 STDIN으로 들어오므로 Reader 스레드의 파서가 받아, 같은 종류의 가장 오래된 질의와 짝짓습니다.
+     *   (터미널은 요청 순서대로 응답하므로, 종류별 FIFO로 충분함)
+     *   등록을 먼저 하므로, 응답이 아무리 빨리 와도 놓치지 않습니다.
      */
-    std::optional<Coord> Device::GetCursorPosMs( const int timeout_ms )
+    void Device::Query( TermQuery query, int arg, QueryCallback callback, std::chrono::milliseconds timeout )
     {
-        // 1. 터미널에 "너 지금 커서 어디야?"라고 질문 전송 (Device Status Report)
-        RequestCursorPos(); // sends "\033[6n"
+        GetPtr()->SendQuery( query, arg, std::string(), std::move( callback ), timeout );
+    }
 
-        // 2. 실행 모드 결정: 누가 입력 버퍼(STDIN)를 쥐고 있는가?
-        if( is_input_running_.load() )
-        {
-            // [Case A: Observer Mode] 이미 입력 루프가 돌고 있음
-            std::promise<Coord> p;
-            std::future<Coord>  f = p.get_future();
+    void Device::Query( TermQuery query, std::string_view name, QueryCallback callback, std::chrono::milliseconds timeout )
+    {
+        GetPtr()->SendQuery( query, 0, std::string( name ), std::move( callback ), timeout );
+    }
+
+    void Device::SendQuery( TermQuery query, int arg, std::string name, QueryCallback callback, std::chrono::milliseconds timeout )
+    {
+        EnsureRawMode();
+        EnsureReaderThread();
 
+        std::string request;
+        switch( query )
+        {
+            case TermQuery::CURSOR_POS:       request = "\033[6n";  break;
+            case TermQuery::PRIMARY_DA:       request = "\033[c";   break;
+            case TermQuery::SECONDARY_DA:     request = "\033[>c";  break;
+            case TermQuery::MODE:             request = "\033[?" + std::to_string( arg ) + "$p"; break;
+            case TermQuery::VERSION:          request = "\033[>0q"; break;
+            case TermQuery::FOREGROUND_COLOR: request = "\033]10;?\033\\"; break;
+            case TermQuery::BACKGROUND_COLOR: request = "\033]11;?\033\\"; break;
+            case TermQuery::PALETTE_COLOR:    request = "\033]4;" + std::to_string( arg ) + ";?\033\\"; break;
+            case TermQuery::KEYBOARD_FLAGS:   request = "\033[?u";  break;
+            case TermQuery::TERMCAP:
             {
-                std::lock_guard<std::mutex> lock( cursor_promise_mtx_ );
+                // 이름은 16진수로 인코딩하여 보냄 (예: "RGB" -> 524742)
+                static constexpr char HEX[] = "0123456789ABCDEF";
+                request = "\033P+q";
+                for( unsigned char ch : name ) { request += HEX[ch >> 4]; request += HEX[ch & 0x0F]; }
+                request += "\033\\";
+                break;
+            }
+        }
 
-                // 이미 다른 요청이 진행 중임 (Busy)
-                if( cursor_promise_ != nullptr )
-                    return std::nullopt;
+        {
+            std::lock_guard<std::mutex> lock( query_mtx_ );
+            queries_.push_back( { query, arg, std::move( name ), std::move( callback ),
+                                  std::chrono::steady_clock::now() + std::max( timeout, std::chrono::milliseconds( 0 ) ) } );
+        }
 
-                // "결과 나오면 여기다 넣어줘" 라고 등록
-                cursor_promise_ = &p;
-            }
+        Screen::Write( request );
 
-            // 결과가 도착할 때까지 대기
-            std::future_status status = f.wait_for( std::chrono::milliseconds( timeout_ms ) );
+        Notify( EVENT_CODE_WAKEUP ); // Reader 스레드가 새 제한 시간으로 대기하도록
+    }
 
-            // 대기 끝, 포인터 해제 (중요: Dangling Pointer 방지)
-            {
-                std::lock_guard<std::mutex> lock( cursor_promise_mtx_ );
-                cursor_promise_ = nullptr;
-            }
+    bool Device::HasPendingQuery( TermQuery query )
+    {
+        std::lock_guard<std::mutex> lock( query_mtx_ );
+        return std::any_of( queries_.begin(), queries_.end(), [&]( const PendingQuery& q ) { return q.query == query; } );
+    }
 
-            if( status == std::future_status::ready ){
-                return f.get();
-            }
-            else { return std::nullopt; } // Timeout
+    /**
+     * @brief 버퍼가 대기 중인 질의의 문자열 응답(DCS: XTVERSION, OSC: 색상)으로 시작하는지 확인합니다.
+     * @note  평소의 ESC P, ESC ]는 Alt+P, Alt+] 키이므로, 해당 질의를 기다리는 중일 때만 응답으로 봅니다.
+     */
+    bool Device::IsAwaitingStringReply( std::string_view buf )
+    {
+        if( buf.size() < 2 || buf[0] != 27 || ( buf[1] != 'P' && buf[1] != ']' ) ) return false;
+
+        std::lock_guard<std::mutex> lock( query_mtx_ );
+        return std::any_of( queries_.begin(), queries_.end(), [&]( const PendingQuery& q ) {
+            if( buf[1] == 'P' ) return q.query == TermQuery::VERSION || q.query == TermQuery::TERMCAP;
+            return q.query == TermQuery::FOREGROUND_COLOR || q.query == TermQuery::BACKGROUND_COLOR ||
+                   q.query == TermQuery::PALETTE_COLOR;
+        } );
+    }
+
+    /**
+     * @brief  응답을 같은 종류의 가장 오래된 질의에 전달합니다. (MODE, PALETTE_COLOR는 인자까지 일치해야 함)
+     * @return 짝지을 질의가 없으면 false (요청하지 않은 응답)
+     */
+    bool Device::CompleteQuery( QueryReply reply )
+    {
+        QueryCallback callback;
+        {
+            std::lock_guard<std::mutex> lock( query_mtx_ );
+
+            bool match_arg  = ( reply.query == TermQuery::MODE || reply.query == TermQuery::PALETTE_COLOR );
+            bool match_name = ( reply.query == TermQuery::TERMCAP && !reply.name.empty() );
+            auto it = std::find_if( queries_.begin(), queries_.end(), [&]( const PendingQuery& q ) {
+                return q.query == reply.query && ( !match_arg || q.arg == reply.arg ) && ( !match_name || q.name == reply.name );
+            } );
+            if( it == queries_.end() ) return false;
+
+            reply.arg  = it->arg;
+            reply.name = it->name;
+            callback  = std::move( it->callback );
+            queries_.erase( it );
         }
-        else
+
+        // callback이 다른 질의를 보낼 수 있으므로 잠금 밖에서 호출
+        reply.ok = true;
+        if( callback ) callback( reply );
+        return true;
+    }
+
+    void Device::ExpireQueries( std::chrono::steady_clock::time_point now )
+    {
+        std::vector<PendingQuery> expired;
         {
-            // [Case B: Direct Mode] 내가 직접 읽어야 함
-            using namespace std::chrono;
-            auto start_time = steady_clock::now();
+            std::lock_guard<std::mutex> lock( query_mtx_ );
+            for( auto it = queries_.begin(); it != queries_.end(); ) {
+                if( it->deadline <= now ) { expired.push_back( std::move( *it ) ); it = queries_.erase( it ); }
+                else ++it;
+            }
+        }
 
-            while( true )
-            {
-                // 남은 시간 계산
-                auto elapsed   = duration_cast<milliseconds>( steady_clock::now() - start_time );
-                int  remaining = timeout_ms - (int)elapsed.count();
+        for( auto& q : expired ) {
+            QueryReply reply;
+            reply.query = q.query;
+            reply.arg   = q.arg;
+            reply.name  = std::move( q.name );
+            if( q.callback ) q.callback( reply ); // ok == false
+        }
+    }
 
-                if( remaining <= 0 ) break;
+    std::chrono::steady_clock::time_point Device::NextQueryDeadline( void )
+    {
+        std::lock_guard<std::mutex> lock( query_mtx_ );
 
-                // 재귀적으로 GetInputMs를 호출하지만, 이번엔 내가 점유자(Owner)가 됨
-                auto input_opt = GetInputMs( remaining );
+        TimePoint earliest = TimePoint::max();
+        for( const auto& q : queries_ ) earliest = std::min( earliest, q.deadline );
+        return earliest;
+    }
 
-                if( !input_opt.has_value() ) continue;
+    /**
+     * @brief 커서 위치 질의를 보내고 응답을 기다립니다.
+     *
+     * @details
+     *   Query( CURSOR_POS )의 callback이 결과를 넣고 깨워 줄 때까지 대기합니다.
+     *   (그 사이의 키/마우스 입력은 구독자에게 그대로 전달됨)
+     *   callback은 응답이나 타임아웃 중 하나로 반드시 호출되므로, 대기가 영원히 이어지지 않습니다.
+     */
+    std::optional<Coord> Device::GetCursorPosMs( const int timeout_ms )
+    {
+        struct Waiter
+        {
+            std::mutex              mtx;
+            std::condition_variable cv;
+            bool                    done = false;
+            std::optional<Coord>    pos;
+        };
+        auto waiter = std::make_shared<Waiter>();
+
+        Query( TermQuery::CURSOR_POS, [waiter]( const QueryReply& reply ) {
+            std::lock_guard<std::mutex> lock( waiter->mtx );
+            if( reply.ok ) waiter->pos = reply.cursor;
+            waiter->done = true;
+            waiter->cv.notify_all();
+        }, std::chrono::milliseconds( std::max( timeout_ms, 0 ) ) );
+
+        std::unique_lock<std::mutex> lock( waiter->mtx );
+        waiter->cv.wait( lock, [&] { return waiter->done; } );
+        return waiter->pos;
+    }
 
-                // 내가 원하던 커서 이벤트가 맞나?
-                // (이때 키보드나 마우스 입력이 오면 무시/유실될 수 있음 -> Direct Mode의 한계)
-                if( input_opt.value() == DeviceInputCode::CURSOR_EVENT ) {
-                    return last_cursor_pos_;
-                }
-            }
-            return std::nullopt;
+    /**
+     * @brief  10진수 문자열을 정수로 변환합니다. (할당/예외 없음)
+     * @return 비어 있거나 숫자가 아닌 문자가 있으면 false
+     */
+    static bool ParseDecimal( std::string_view digits, int& out )
+    {
+        if( digits.empty() || digits.size() > 9 ) return false;
+
+        int value = 0;
+        for( char ch : digits ) {
+            if( ch < '0' || ch > '9' ) return false;
+            value = value * 10 + ( ch - '0' );
         }
+        out = value;
+        return true;
     }
 
     /**
@@ -556,151 +1553,73 @@ namespace cx
      * @param  buf 입력된 로우 데이터 버퍼
      * @return {식별된 키 코드, 사용된 바이트 길이}
      * 길이가 0이면 "데이터가 더 필요함(Incomplete)"을 의미합니다.
+     *
+     * @details
+     *   이스케이프 시퀀스는 키 시퀀스 표(cx_keymap.hpp)로 만든 Trie에서 먼저 찾고,
+     *   표에 없는 것(마우스, 커서 위치 응답, 알 수 없는 CSI)만 일반 규칙으로 처리합니다.
      */
-    std::pair<DeviceInputCode, size_t> Device::ParseInputBuffer( const std::string& buf )
+    std::pair<DeviceInputCode, size_t> Device::ParseInputBuffer( std::string_view buf )
     {
         if( buf.empty() )
             return { DeviceInputCode::NONE, 0 };
 
-        size_t len = buf.length();
-
         // ESC(27)로 시작하는 시퀀스 처리 (ESC Key, Arrow Keys, F-Keys, Mouse)
         if( buf[0] == static_cast<int>( cx::DeviceInputCode::ESC ) )
         {
             // 데이터가 너무 짧으면 더 기다려야 함 (최소 2바이트 필요)
-            if( len < 2 )
+            if( buf.length() < 2 )
                 return { DeviceInputCode::NONE, 0 };
 
-            // '[' (CSI - Control Sequence Introducer)
-            if( buf[1] == '[' )
+            auto match = KEY_TRIE.Find( buf );
+            switch( match.result )
             {
-                if( len < 3 )
-                    return { DeviceInputCode::NONE, 0 };
+                case decltype( KEY_TRIE )::Result::MATCH:
+                    last_key_mods_ |= match.mods;
+                    return { match.code, match.length };
 
-                // Mouse Event (SGR Mode: \033[<...)
-                if( buf[2] == '<' )
-                    return ParseMouseSequence( buf );
+                case decltype( KEY_TRIE )::Result::PARTIAL:
+                    return { DeviceInputCode::NONE, 0 };
 
-                // Focus Event (I/O) - 무시하고 넘어감 (3바이트 소비)
-                if( buf[2] == 'I' || buf[2] == 'O' )
-                    return { DeviceInputCode::NONE, 3 };
+                default: break;
+            }
 
-                // 숫자 시작 (F-Key, Insert/Del, Cursor Pos) : \033[15~ or \033[24;1R
-                if( buf[2] >= '0' && buf[2] <= '9' )
-                {
-                    // 종료 문자(~, R 등)를 찾음
-                    size_t t_pos = std::string::npos;
-                    for( size_t i = 2; i < len; ++i )
-                    {
-                        // ASCII 0x40(@) ~ 0x7E(~) 사이의 문자가 터미네이터임
-                        if( buf[i] >= 0x40 && buf[i] <= 0x7E ) { t_pos = i; break; }
-                    }
+            // 표에 없는 CSI 시퀀스 (수식 키 조합, 마우스, 커서 위치 응답 등)
+            if( buf[1] == '[' )
+                return ParseCsiSequence( buf );
 
-                    if( t_pos == std::string::npos ) // 아직 덜 옴
-                        return { DeviceInputCode::NONE, 0 };
-
-                    size_t seq_len    = t_pos + 1;
-                    char   terminator = buf[t_pos];
-
-                    // 'R': Cursor Position Report (\033[row;colR)
-                    if( terminator == 'R' )
-                    {
-                        int r = 0, c = 0;
-                        size_t semi_pos = buf.find( ';', 2 );
-
-                        if( semi_pos != std::string::npos && semi_pos < t_pos )
-                        {
-                            try {
-                                // 문자열 파싱 ( Row;Col )
-                                r = std::stoi( buf.substr( 2, semi_pos - 2 ) );
-                                c = std::stoi( buf.substr( semi_pos + 1, t_pos - (semi_pos + 1) ) );
-                            }
-                            catch(...) { return { DeviceInputCode::NONE, seq_len }; }
-
-                            // ANSI(1-based) -> User(0-based) 변환
-                            last_cursor_pos_.x = c - 1;
-                            last_cursor_pos_.y = r - 1;
-
-                            return { DeviceInputCode::CURSOR_EVENT, seq_len };
-                        }
-                    }
+            // 질의 응답 문자열 (DCS: XTVERSION, OSC: 색상)
+            if( IsAwaitingStringReply( buf ) )
+                return ParseStringReply( buf );
 
-                    // '~': Extended Keys (Home, End, F1~F12, etc.)
-                    if( terminator == '~' )
-                    {
-                        DeviceInputCode k = DeviceInputCode::NONE;
-
-                        // VT100/xterm 호환 키 매핑 로직
-                        // 예: \033[15~ -> F5
-                        if( buf[2] == '1' ) {
-                            // [NEW] Tera Term 등에서 F1~F4를 [11~ 스타일로 보내는 경우 처리
-                            std::string sub = buf.substr(2, 2);
-                            if      ( sub == "11" ) k = DeviceInputCode::F1; // \033[11~
-                            else if ( sub == "12" ) k = DeviceInputCode::F2; // \033[12~
-                            else if ( sub == "13" ) k = DeviceInputCode::F3; // \033[13~
-                            else if ( sub == "14" ) k = DeviceInputCode::F4; // \033[14~
-
-                            // [Existing] F5 이상
-                            else if ( sub == "15" ) k = DeviceInputCode::F5;
-                            else if ( sub == "17" ) k = DeviceInputCode::F6;
-                            else if ( sub == "18" ) k = DeviceInputCode::F7;
-                            else if ( sub == "19" ) k = DeviceInputCode::F8;
-                            else if ( sub == "1~" ) k = DeviceInputCode::HOME; // \033[1~ case
-                        }
-                        else if( buf[2] == '2' ) {
-                            std::string sub = buf.substr(2, 2);
-                            if      ( sub == "20" ) k = DeviceInputCode::F9;
-                            else if ( sub == "21" ) k = DeviceInputCode::F10;
-                            else if ( sub == "23" ) k = DeviceInputCode::F11;
-                            else if ( sub == "24" ) k = DeviceInputCode::F12;
-                            else if ( sub == "2~" ) k = DeviceInputCode::INSERT;
-                        }
-                        else if( buf[2] == '3' ) k = DeviceInputCode::DEL;
-                        else if( buf[2] == '4' ) k = DeviceInputCode::END;
-                        else if( buf[2] == '5' ) k = DeviceInputCode::PAGE_UP;
-                        else if( buf[2] == '6' ) k = DeviceInputCode::PAGE_DOWN;
-
-                        return { k, seq_len };
-                    }
-                    // 알 수 없는 시퀀스는 소비하고 무시함
-                    return { DeviceInputCode::NONE, seq_len };
-                }
+            // 표에 없는 SS3 시퀀스 : 소비하고 무시
+            if( buf[1] == 'O' )
+                return { DeviceInputCode::NONE, 3 };
 
-                // 문자 커맨드 (화살표 키 등) : \033[A
-                switch( buf[2] )
-                {
-                    case 'A': return { DeviceInputCode::ARROW_UP,    3 };
-                    case 'B': return { DeviceInputCode::ARROW_DOWN,  3 };
-                    case 'C': return { DeviceInputCode::ARROW_RIGHT, 3 };
-                    case 'D': return { DeviceInputCode::ARROW_LEFT,  3 };
-                    case 'H': return { DeviceInputCode::HOME,        3 };
-                    case 'F': return { DeviceInputCode::END,         3 };
-                }
+            // ESC ESC : 뒤가 시퀀스면 Alt + 특수 키(rxvt 방식), 아니면 ESC 키
+            if( buf[1] == 27 ) {
+                if( buf.length() < 3 || ( buf[2] != '[' && buf[2] != 'O' ) )
+                    return { DeviceInputCode::ESC, 1 };
             }
-            // SS3 (Single Shift 3) - \033O... (F1~F4)
-            else if( buf[1] == 'O' )
-            {
-                if( len < 3 )
-                    return { DeviceInputCode::NONE, 0 };
 
-                switch( buf[2] )
-                {
-                    case 'P': return { DeviceInputCode::F1,   3 };
-                    case 'Q': return { DeviceInputCode::F2,   3 };
-                    case 'R': return { DeviceInputCode::F3,   3 };
-                    case 'S': return { DeviceInputCode::F4,   3 };
-                    case 'H': return { DeviceInputCode::HOME, 3 };
-                    case 'F': return { DeviceInputCode::END,  3 };
-                }
-            }
-            // 그냥 ESC 키 하나만 눌린 경우 (매우 빠르게 판단해야 함)
-            if( len == 1 )
-                return { DeviceInputCode::ESC, 1 };
+            // ESC + 키 : Alt(Meta) 조합 (대부분의 터미널이 Alt를 ESC 접두로 보냄)
+            auto [ key, len ] = ParseInputBuffer( buf.substr( 1 ) );
+            if( len == 0 )
+                return { DeviceInputCode::NONE, 0 };
+            if( key == DeviceInputCode::NONE )
+                return { DeviceInputCode::NONE, len + 1 };
+
+            last_key_mods_ |= MOD_ALT;
+            return { key, len + 1 };
         }
 
         // 일반 ASCII 문자 (A, a, 1, Enter...)
         unsigned char c = static_cast<unsigned char>( buf[0] );
 
+        // UTF-8 멀티바이트 문자 (한글 등)
+        if( c >= 0x80 ) {
+            return ParseUtf8Char( buf );
+        }
+
         // Backspace 처리: ASCII 8(^H) 또는 127(^?)
         // Tera Term은 8을 보내고, 다른 터미널은 127을 보내기도 함
         if( c == 8 || c == 127 ) {
@@ -718,27 +1637,428 @@ namespace cx
              return { DeviceInputCode::TAB, 1 }; // TAB이 정의되어 있다면
         }
 
+        // Ctrl + 문자: 제어 문자(0 ~ 31)를 원래 키 + MOD_CTRL로 변환
+        // (0: Ctrl+Space, 1 ~ 26: Ctrl+a ~ z, 28 ~ 31: Ctrl+\ ] ^ _)
+        if( c < 32 ) {
+            last_key_mods_ |= MOD_CTRL;
+            if( c == 0 )  return { DeviceInputCode::SPACE, 1 };
+            if( c <= 26 ) return { static_cast<DeviceInputCode>( 'a' + c - 1 ), 1 };
+            return { static_cast<DeviceInputCode>( c + 0x40 ), 1 };
+        }
+
         // 그 외 일반 ASCII 문자 (A, a, 1, ...)
+        last_codepoint_ = c;
         return { static_cast<DeviceInputCode>( c ), 1 };
     }
 
+    /**
+     * @brief  UTF-8 멀티바이트 문자 하나를 TEXT_EVENT로 변환합니다.
+     * @return 문자가 덜 도착했으면 길이 0, 잘못된 바이트는 1바이트 소비 후 무시
+     */
+    std::pair<DeviceInputCode, size_t> Device::ParseUtf8Char( std::string_view buf )
+    {
+        size_t need = Util::GetUtf8SeqLength( static_cast<unsigned char>( buf[0] ) );
+        if( need == 1 ) // 선행 바이트가 아님 (연속 바이트가 홀로 옴)
+            return { DeviceInputCode::NONE, 1 };
+
+        if( buf.length() < need ) // 아직 덜 옴
+            return { DeviceInputCode::NONE, 0 };
+
+        for( size_t i = 1; i < need; ++i ) {
+            if( ( static_cast<unsigned char>( buf[i] ) & 0xC0 ) != 0x80 )
+                return { DeviceInputCode::NONE, 1 };
+        }
+
+        uint32_t codepoint = 0;
+        Util::DecodeUtf8( buf.data(), need, codepoint );
+        if( codepoint == 0 )
+            return { DeviceInputCode::NONE, need };
+
+        last_codepoint_ = codepoint;
+        return { DeviceInputCode::TEXT_EVENT, need };
+    }
+
+    /**
+     * @brief  키 시퀀스 표에 없는 CSI(ESC [) 시퀀스를 처리합니다.
+     *
+     * @details
+     *   - ESC [ < ... M/m   : SGR 마우스
+     *   - ESC [ row ; col R : 커서 위치 응답
+     *   - ESC [ 1 ; m X     : 수식 키 + 특수 키 (xterm, 예: Ctrl+Up = ESC[1;5A)
+     *   - ESC [ n ; m ~     : 수식 키 + 편집/기능 키 (예: Shift+F5 = ESC[15;2~)
+     *   - ESC [ ... u       : kitty 키보드 프로토콜 키 / 기능 질의 응답(ESC[?flags u)
+     *   - 그 외 : 종료 문자(0x40 ~ 0x7E)까지 소비하고 무시
+     *
+     *   kitty 프로토콜은 수식 키 파라미터 뒤에 이벤트 종류를 붙입니다. (예: Up 뗌 = ESC[1;1:3A)
+     *
+     *   수식 키 조합은 파라미터를 뗀 기본 시퀀스를 키 시퀀스 표에서 찾으므로,
+     *   표에 기본 시퀀스만 있으면 모든 수식 키 조합이 자동으로 처리됩니다.
+     */
+    std::pair<DeviceInputCode, size_t> Device::ParseCsiSequence( std::string_view buf )
+    {
+        if( buf.length() < 3 )
+            return { DeviceInputCode::NONE, 0 };
+
+        // Mouse Event (SGR Mode: \033[<...)
+        if( buf[2] == '<' )
+            return ParseMouseSequence( buf );
+
+        // 종료 문자를 찾음 (ASCII 0x40(@) ~ 0x7E(~) 사이의 문자가 터미네이터임)
+        size_t t_pos = std::string_view::npos;
+        for( size_t i = 2; i < buf.length(); ++i ) {
+            if( buf[i] >= 0x40 && buf[i] <= 0x7E ) { t_pos = i; break; }
+        }
+
+        if( t_pos == std::string_view::npos ) // 아직 덜 옴
+            return { DeviceInputCode::NONE, 0 };
+
+        size_t seq_len  = t_pos + 1;
+        char   final_ch = buf[t_pos];
+
+        // 'R'은 Ctrl+F3(ESC[1;5R)과 커서 위치 응답(ESC[1;5R)이 같은 모양이므로,
+        // 커서 위치를 요청 중이면 응답으로 취급
+        bool cursor_pending = ( final_ch == 'R' ) && HasPendingQuery( TermQuery::CURSOR_POS );
+
+        std::string_view params = buf.substr( 2, t_pos - 2 );
+
+        // 'c': 장치 속성 응답 (DA1: ESC[?...c, DA2: ESC[>...c) / 'y': 모드 상태 응답 (DECRQM: ESC[?mode;status$y)
+        if( ( final_ch == 'c' && ( params.starts_with( '?' ) || params.starts_with( '>' ) ) ) ||
+            ( final_ch == 'y' && params.starts_with( '?' ) && params.ends_with( '$' ) ) )
+        {
+            QueryReply reply;
+            reply.query = ( final_ch == 'y' )    ? TermQuery::MODE
+                        : ( params[0] == '?' )   ? TermQuery::PRIMARY_DA
+                        :                          TermQuery::SECONDARY_DA;
+
+            std::string_view list = params.substr( 1, params.size() - 1 - ( final_ch == 'y' ? 1 : 0 ) );
+            while( !list.empty() ) {
+                size_t semi  = list.find( ';' );
+                int    value = 0;
+                if( ParseDecimal( list.substr( 0, semi ), value ) ) reply.params.push_back( value );
+                list = ( semi == std::string_view::npos ) ? std::string_view() : list.substr( semi + 1 );
+            }
+            if( reply.query == TermQuery::MODE && !reply.params.empty() ) reply.arg = reply.params[0];
+
+            CompleteQuery( std::move( reply ) ); // 요청하지 않은 응답은 버림 (키 입력이 아님)
+            return { DeviceInputCode::NONE, seq_len };
+        }
+
+        // 'u': kitty 키보드 프로토콜
+        if( final_ch == 'u' )
+        {
+            int flags = 0;
+            if( params.starts_with( '?' ) && ParseDecimal( params.substr( 1 ), flags ) ) {
+                QueryReply reply; // 기능 질의 응답 (지원 확인)
+                reply.query  = TermQuery::KEYBOARD_FLAGS;
+                reply.params = { flags };
+                CompleteQuery( std::move( reply ) );
+                return { DeviceInputCode::NONE, seq_len };
+            }
+            return { ParseKittyKey( params ), seq_len };
+        }
+
+        // 수식 키 파라미터 : first ; modifier[:event]
+        size_t semi  = params.find( ';' );
+        int    first = 0;
+        int    modp  = 0;
+        int    kind  = 1;
+
+        std::string_view mod_field = ( semi != std::string_view::npos ) ? params.substr( semi + 1 ) : std::string_view();
+        size_t           colon     = mod_field.find( ':' );
+        if( colon != std::string_view::npos ) {
+            if( !ParseDecimal( mod_field.substr( colon + 1 ), kind ) ) kind = 0;
+            mod_field = mod_field.substr( 0, colon );
+        }
+
+        if( !cursor_pending && semi != std::string_view::npos &&
+            ParseDecimal( params.substr( 0, semi ), first ) &&
+            ParseDecimal( mod_field, modp ) && modp >= 1 && kind >= 1 && kind <= 3 &&
+            ( final_ch == '~' || first == 1 ) )
+        {
+            // 기본 시퀀스 재구성 (스택 버퍼, 할당 없음) : ESC [ first ~  또는  ESC [ X
+            char   base[16] = { '\033', '[' };
+            size_t base_len = 2;
+            if( final_ch == '~' ) {
+                if( semi > sizeof(base) - 3 ) return { DeviceInputCode::NONE, seq_len };
+                for( size_t i = 0; i < semi; ++i ) base[base_len++] = params[i];
+            }
+            base[base_len++] = final_ch;
+
+            auto match = KEY_TRIE.Find( std::string_view( base, base_len ) );
+
+            // F1 ~ F4는 표에 SS3(ESC O P) 형식으로 있음
+            if( match.result != decltype( KEY_TRIE )::Result::MATCH && final_ch != '~' ) {
+                base[1] = 'O';
+                match   = KEY_TRIE.Find( std::string_view( base, base_len ) );
+            }
+
+            if( match.result == decltype( KEY_TRIE )::Result::MATCH && match.code != DeviceInputCode::NONE ) {
+                last_key_mods_  |= static_cast<uint8_t>( ( modp - 1 ) & 0x0F ) | match.mods;
+                last_key_action_ = static_cast<KeyAction>( kind - 1 );
+                return { match.code, seq_len };
+            }
+        }
+
+        // 'R': Cursor Position Report (\033[row;colR)
+        if( final_ch == 'R' )
+        {
+            size_t semi_pos = buf.find( ';', 2 );
+            int    r = 0, c = 0;
+
+            // 문자열 파싱 ( Row;Col ) - 숫자가 아니면 무시
+            if( semi_pos < t_pos &&
+                ParseDecimal( buf.substr( 2, semi_pos - 2 ), r ) &&
+                ParseDecimal( buf.substr( semi_pos + 1, t_pos - (semi_pos + 1) ), c ) )
+            {
+                // ANSI(1-based) -> User(0-based) 변환
+                last_cursor_pos_.x = c - 1;
+                last_cursor_pos_.y = r - 1;
+
+                return { DeviceInputCode::CURSOR_EVENT, seq_len };
+            }
+        }
+
+        // 알 수 없는 시퀀스는 소비하고 무시함
+        return { DeviceInputCode::NONE, seq_len };
+    }
+
+    /**
+     * @brief  "rgb:RRRR/GGGG/BBBB" 형식(성분당 1 ~ 4자리 16진수)의 색상을 8비트 RGB로 변환합니다.
+     * @return 형식이 다르면 false
+     */
+    static bool ParseColorSpec( std::string_view spec, Rgb& out )
+    {
+        if( !spec.starts_with( "rgb:" ) ) return false;
+        spec.remove_prefix( 4 );
+
+        uint8_t* channels[3] = { &out.r, &out.g, &out.b };
+        for( int i = 0; i < 3; ++i )
+        {
+            size_t           slash = spec.find( '/' );
+            std::string_view part  = spec.substr( 0, slash );
+            if( part.empty() || part.size() > 4 ) return false;
+
+            uint32_t value = 0;
+            for( char ch : part ) {
+                int digit = ( ch >= '0' && ch <= '9' ) ? ch - '0'
+                          : ( ch >= 'a' && ch <= 'f' ) ? ch - 'a' + 10
+                          : ( ch >= 'A' && ch <= 'F' ) ? ch - 'A' + 10 : -1;
+                if( digit < 0 ) return false;
+                value = value * 16 + static_cast<uint32_t>( digit );
+            }
+
+            uint32_t max_value = ( 1u << ( 4 * part.size() ) ) - 1; // 자릿수에 따른 최댓값 (f, ff, fff, ffff)
+            *channels[i] = static_cast<uint8_t>( ( value * 255 + max_value / 2 ) / max_value );
+
+            spec = ( slash == std::string_view::npos ) ? std::string_view() : spec.substr( slash + 1 );
+        }
+        return true;
+    }
+
+    /// @brief 16진수 문자열을 바이트열로 변환합니다. (XTGETTCAP, 잘못된 글자는 건너뜀)
+    static std::string HexDecode( std::string_view hex )
+    {
+        auto nibble = []( char ch ) {
+            return ( ch >= '0' && ch <= '9' ) ? ch - '0'
+                 : ( ch >= 'a' && ch <= 'f' ) ? ch - 'a' + 10
+                 : ( ch >= 'A' && ch <= 'F' ) ? ch - 'A' + 10 : -1;
+        };
+
+        std::string out;
+        for( size_t i = 0; i + 1 < hex.size(); i += 2 ) {
+            int hi = nibble( hex[i] ), lo = nibble( hex[i + 1] );
+            if( hi >= 0 && lo >= 0 ) out += static_cast<char>( ( hi << 4 ) | lo );
+        }
+        return out;
+    }
+
+    /**
+     * @brief  질의에 대한 문자열 응답(DCS, OSC)을 처리합니다.
+     *
+     * @details
+     *   - DCS > | text ST              : XTVERSION (터미널 이름과 버전)
+     *   - DCS 1 + r name = value ST    : XTGETTCAP (0 + r 이면 없음)
+     *   - OSC 10 ; spec ST / OSC 11 ... : 기본 글자색 / 배경색
+     *   - OSC 4 ; index ; spec ST      : 팔레트 색
+     *   ST는 ESC \ 또는 BEL(0x07)입니다. 응답은 키 입력이 아니므로 항상 NONE을 반환합니다.
+     */
+    std::pair<DeviceInputCode, size_t> Device::ParseStringReply( std::string_view buf )
+    {
+        // 종료 문자(ST) 찾기
+        size_t body_end = std::string_view::npos;
+        size_t seq_len  = 0;
+        for( size_t i = 2; i < buf.size(); ++i ) {
+            if( buf[i] == 0x07 ) { body_end = i; seq_len = i + 1; break; }
+            if( buf[i] == 27 && i + 1 < buf.size() && buf[i + 1] == '\\' ) { body_end = i; seq_len = i + 2; break; }
+        }
+
+        if( body_end == std::string_view::npos ) // 아직 덜 옴
+            return { DeviceInputCode::NONE, 0 };
+
+        std::string_view body = buf.substr( 2, body_end - 2 );
+
+        QueryReply reply;
+        if( buf[1] == 'P' && ( body.starts_with( "1+r" ) || body.starts_with( "0+r" ) ) )
+        {
+            // XTGETTCAP : 1+r 이름=값 (있음) / 0+r 이름 (없음), 이름과 값은 16진수
+            std::string_view pair = body.substr( 3 );
+            size_t           eq   = pair.find( '=' );
+
+            reply.query  = TermQuery::TERMCAP;
+            reply.params = { body[0] == '1' ? 1 : 0 };
+            reply.name   = HexDecode( pair.substr( 0, eq ) );
+            if( eq != std::string_view::npos ) reply.text = HexDecode( pair.substr( eq + 1 ) );
+        }
+        else if( buf[1] == 'P' )
+        {
+            if( !body.starts_with( ">|" ) ) return { DeviceInputCode::NONE, seq_len };
+            reply.query = TermQuery::VERSION;
+            reply.text  = std::string( body.substr( 2 ) );
+        }
+        else
+        {
+            size_t semi = body.find( ';' );
+            int    code = 0;
+            if( semi == std::string_view::npos || !ParseDecimal( body.substr( 0, semi ), code ) )
+                return { DeviceInputCode::NONE, seq_len };
+            body = body.substr( semi + 1 );
+
+            if( code == 10 )      reply.query = TermQuery::FOREGROUND_COLOR;
+            else if( code == 11 ) reply.query = TermQuery::BACKGROUND_COLOR;
+            else if( code == 4 ) {
+                semi = body.find( ';' );
+                if( semi == std::string_view::npos || !ParseDecimal( body.substr( 0, semi ), reply.arg ) )
+                    return { DeviceInputCode::NONE, seq_len };
+                reply.query = TermQuery::PALETTE_COLOR;
+                body        = body.substr( semi + 1 );
+            }
+            else return { DeviceInputCode::NONE, seq_len };
+
+            reply.text = std::string( body );
+            ParseColorSpec( body, reply.rgb );
+        }
+
+        CompleteQuery( std::move( reply ) );
+        return { DeviceInputCode::NONE, seq_len };
+    }
+
+    /**
+     * @brief  kitty 키보드 프로토콜의 CSI u 키 이벤트를 변환합니다.
+     * @param  params ESC [ 와 u 사이의 파라미터 (key[:shifted[:base]] ; modifiers[:event] ; text)
+     * @return 변환한 키 코드 (표현할 수 없는 키는 NONE)
+     *
+     * @details
+     *   - 문자 키는 기존 입력과 같게 맞춥니다. (Shift+a -> 'A', 수식 키 없음 / Ctrl+a -> 'a' + MOD_CTRL)
+     *   - 키패드 키(U+E000 영역의 57399 ~ 57426)는 일반 숫자/기호/특수 키로 변환합니다.
+     *   - 수식 키 단독 입력, 미디어 키 등 대응하는 코드가 없는 키는 무시합니다.
+     */
+    DeviceInputCode Device::ParseKittyKey( std::string_view params )
+    {
+        // 필드 분리 (';' 기준, 최대 3개)
+        std::string_view fields[3];
+        for( int i = 0; i < 3 && !params.empty(); ++i ) {
+            size_t semi = params.find( ';' );
+            fields[i] = params.substr( 0, semi );
+            params    = ( semi == std::string_view::npos ) ? std::string_view() : params.substr( semi + 1 );
+        }
+
+        // 1. key[:shifted[:base]]
+        std::string_view key_field = fields[0];
+        size_t           colon     = key_field.find( ':' );
+        int              key       = 0;
+        int              shifted   = 0;
+        if( !ParseDecimal( key_field.substr( 0, colon ), key ) ) return DeviceInputCode::NONE;
+        if( colon != std::string_view::npos ) {
+            std::string_view alt = key_field.substr( colon + 1 );
+            ParseDecimal( alt.substr( 0, alt.find( ':' ) ), shifted );
+        }
+
+        // 2. modifiers[:event] (생략 시 1 = 수식 키 없음, 누름)
+        std::string_view mod_field = fields[1];
+        int              modp      = 1;
+        int              kind      = 1;
+        colon = mod_field.find( ':' );
+        if( colon != std::string_view::npos ) ParseDecimal( mod_field.substr( colon + 1 ), kind );
+        if( !mod_field.empty() ) ParseDecimal( mod_field.substr( 0, colon ), modp );
+
+        uint8_t mods = static_cast<uint8_t>( ( std::max( modp, 1 ) - 1 ) & 0x0F );
+        last_key_action_ = ( kind == 2 ) ? KeyAction::REPEAT : ( kind == 3 ) ? KeyAction::RELEASE : KeyAction::PRESS;
+
+        // Shift가 적용된 글자가 있으면 그 글자로 대체 (KITTY_REPORT_ALTERNATE)
+        if( ( mods & MOD_SHIFT ) && shifted > 0 ) {
+            key   = shifted;
+            mods &= ~MOD_SHIFT;
+        }
+        else if( ( mods & MOD_SHIFT ) && key >= 'a' && key <= 'z' ) {
+            key  -= 'a' - 'A';
+            mods &= ~MOD_SHIFT;
+        }
+
+        last_key_mods_ |= mods;
+
+        // 3. 키 코드 변환
+        switch( key )
+        {
+            case 9:   return DeviceInputCode::TAB;
+            case 13:  return DeviceInputCode::ENTER;
+            case 27:  return DeviceInputCode::ESC;
+            case 127: return DeviceInputCode::BACKSPACE;
+
+            // 키패드 (KP_0 ~ KP_9, 기호, Enter, 방향/편집 키)
+            case 57409: key = '.'; break;
+            case 57410: key = '/'; break;
+            case 57411: key = '*'; break;
+            case 57412: key = '-'; break;
+            case 57413: key = '+'; break;
+            case 57414: return DeviceInputCode::ENTER;
+            case 57415: key = '='; break;
+            case 57416: key = ','; break;
+            case 57417: return DeviceInputCode::ARROW_LEFT;
+            case 57418: return DeviceInputCode::ARROW_RIGHT;
+            case 57419: return DeviceInputCode::ARROW_UP;
+            case 57420: return DeviceInputCode::ARROW_DOWN;
+            case 57421: return DeviceInputCode::PAGE_UP;
+            case 57422: return DeviceInputCode::PAGE_DOWN;
+            case 57423: return DeviceInputCode::HOME;
+            case 57424: return DeviceInputCode::END;
+            case 57425: return DeviceInputCode::INSERT;
+            case 57426: return DeviceInputCode::DEL;
+            default:
+                if( key >= 57399 && key <= 57408 ) key = '0' + ( key - 57399 );
+                break;
+        }
+
+        if( key >= 32 && key < 127 ) {
+            last_codepoint_ = static_cast<uint32_t>( key );
+            return static_cast<DeviceInputCode>( key );
+        }
+
+        // 사용자 영역(U+E000 ~ U+F8FF)은 kitty의 기능 키 (대응 코드 없음), 그 외는 일반 문자
+        if( key >= 0x80 && !( key >= 0xE000 && key <= 0xF8FF ) && key <= 0x10FFFF ) {
+            last_codepoint_ = static_cast<uint32_t>( key );
+            return DeviceInputCode::TEXT_EVENT;
+        }
+
+        return DeviceInputCode::NONE;
+    }
+
     /**
      * @brief SGR 1006 마우스 시퀀스를 파싱하여 사용자 친화적인 이벤트로 변환합니다.
      *
      * @details
      *   Format : \033[<BUTTON;X;Y;TYPE
-     *   BUTTON : 비트마스크 (왼/오/휠/드래그 정보 포함)
+     *   BUTTON : 비트마스크 (왼/오/휠/드래그, 수식 키 정보 포함)
      *   TYPE   : 'M' (누름/이동), 'm' (뗌)
      */
-    std::pair<DeviceInputCode, size_t> Device::ParseMouseSequence( const std::string& buf )
+    std::pair<DeviceInputCode, size_t> Device::ParseMouseSequence( std::string_view buf )
     {
         // 1. 'M' 또는 'm' 종료 문자 찾기
-        size_t m_pos = std::string::npos;
+        size_t m_pos = std::string_view::npos;
         for( size_t i = 3; i < buf.length(); ++i ){
             if( buf[i] == 'M' || buf[i] == 'm' ) { m_pos = i; break; }
         }
 
-        if( m_pos == std::string::npos ) // 데이터 불충분
+        if( m_pos == std::string_view::npos ) // 데이터 불충분
             return { DeviceInputCode::NONE, 0 };
 
         size_t seq_len = m_pos + 1;
@@ -753,6 +2073,13 @@ namespace cx
         }
 
         int raw_btn         = param[0];
+
+        // 수식 키 비트 (4: Shift, 8: Alt, 16: Ctrl) 분리 후 제거
+        if( raw_btn & 4  ) last_key_mods_ |= MOD_SHIFT;
+        if( raw_btn & 8  ) last_key_mods_ |= MOD_ALT;
+        if( raw_btn & 16 ) last_key_mods_ |= MOD_CTRL;
+        raw_btn &= ~( 4 | 8 | 16 );
+
         last_mouse_state_.x = param[1] - 1; // ANSI(1-based) -> User(0-based) 변환
         last_mouse_state_.y = param[2] - 1; // ANSI(1-based) -> User(0-based) 변환
 
@@ -0,0 +1,907 @@
+#include "cx_pane.hpp"
+
+// System Headers
+#include <pty.h>       // forkpty
+#include <sys/ioctl.h> // TIOCSWINSZ
+#include <sys/wait.h>  // waitpid
+#include <fcntl.h>     // fcntl, O_NONBLOCK
+#include <poll.h>      // poll
+#include <signal.h>    // kill, signal
+#include <unistd.h>    // read, write, execvp
+#include <cerrno>
+#include <cstdlib>     // getenv, setenv
+#include <algorithm>   // std::rotate, std::clamp
+#include <thread>      // std::this_thread::sleep_for
+
+namespace cx
+{
+    // =========================================================================
+    // Construction & Process Management
+    // =========================================================================
+
+    TermPane::TermPane( int cols, int rows, size_t scrollback )
+        : cols_         ( std::max( cols, 1 ) )
+        , rows_         ( std::max( rows, 1 ) )
+        , history_limit_( scrollback )
+    {
+        screen_.assign( rows_, Row( cols_ ) );
+        scroll_bottom_ = rows_ - 1;
+        style_ = base_style_;
+    }
+
+    TermPane::~TermPane()
+    {
+        Terminate();
+    }
+
+    bool TermPane::Spawn( const std::vector<std::string>& argv )
+    {
+        if( pid_ > 0 ) return false; // 이미 실행 중
+
+        struct winsize ws {};
+        ws.ws_col = static_cast<unsigned short>( cols_ );
+        ws.ws_row = static_cast<unsigned short>( rows_ );
+
+        int   fd  = -1;
+        pid_t pid = forkpty( &fd, nullptr, nullptr, &ws );
+        if( pid < 0 ) return false;
+
+        // ---------------------------------------------------------------------
+        // Child Process
+        // ---------------------------------------------------------------------
+        if( pid == 0 )
+        {
+            // cx::Device가 설치한 시그널 핸들러를 상속하지 않도록 기본값으로 복구
+            signal( SIGINT,   SIG_DFL );
+            signal( SIGWINCH, SIG_DFL );
+            signal( SIGTERM,  SIG_DFL );
+            signal( SIGHUP,   SIG_DFL );
+
+            setenv( "TERM", "xterm-256color", 1 );
+
+            if( argv.empty() ) {
+                const char* shell = getenv( "SHELL" );
+                if( shell == nullptr || *shell == '\0' ) shell = "/bin/sh";
+                execl( shell, shell, static_cast<char*>( nullptr ) );
+            }
+            else {
+                std::vector<char*> args;
+                args.reserve( argv.size() + 1 );
+                for( const auto& arg : argv ) args.push_back( const_cast<char*>( arg.c_str() ) );
+                args.push_back( nullptr );
+                execvp( args[0], args.data() );
+            }
+            _exit( 127 ); // exec 실패
+        }
+
+        // ---------------------------------------------------------------------
+        // Parent Process
+        // ---------------------------------------------------------------------
+        // Pump()가 UI 루프를 막지 않도록 넌블로킹으로 설정
+        fcntl( fd, F_SETFL, fcntl( fd, F_GETFL ) | O_NONBLOCK );
+        fcntl( fd, F_SETFD, FD_CLOEXEC );
+
+        pid_         = pid;
+        master_fd_   = fd;
+        exit_status_ = -1;
+
+        Device::WatchFd( master_fd_ );
+        return true;
+    }
+
+    void TermPane::Terminate( void )
+    {
+        if( pid_ > 0 ) kill( pid_, SIGHUP );
+
+        CloseMaster();
+        ReapChild( true );
+    }
+
+    bool TermPane::IsRunning( void )
+    {
+        ReapChild( false );
+        return pid_ > 0;
+    }
+
+    void TermPane::CloseMaster( void )
+    {
+        if( master_fd_ < 0 ) return;
+
+        Device::UnwatchFd( master_fd_ );
+        close( master_fd_ );
+        master_fd_ = -1;
+    }
+
+    /**
+     * @brief 종료된 자식 프로세스를 회수합니다.
+     * @param block true면 최대 100ms 기다린 후에도 살아있을 때 SIGKILL로 강제 종료
+     */
+    void TermPane::ReapChild( bool block )
+    {
+        if( pid_ <= 0 ) return;
+
+        int status = 0;
+        for( int retry = 0; ; ++retry )
+        {
+            pid_t r = waitpid( pid_, &status, WNOHANG );
+            if( r == pid_ || ( r < 0 && errno != EINTR ) ) {
+                exit_status_ = ( r == pid_ ) ? status : -1;
+                pid_ = -1;
+                return;
+            }
+            if( !block ) return;
+
+            if( retry == 10 ) kill( pid_, SIGKILL );
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        }
+    }
+
+    // =========================================================================
+    // I/O
+    // =========================================================================
+
+    size_t TermPane::Pump( size_t max_bytes )
+    {
+        if( master_fd_ < 0 ) return 0;
+
+        char   buf[4096];
+        size_t total = 0;
+
+        while( total < max_bytes )
+        {
+            size_t  want = std::min( sizeof(buf), max_bytes - total );
+            ssize_t n    = read( master_fd_, buf, want );
+
+            if( n > 0 ) {
+                Feed( std::string_view( buf, static_cast<size_t>( n ) ) );
+                total += static_cast<size_t>( n );
+                continue;
+            }
+            if( n < 0 && errno == EINTR ) continue;
+            if( n < 0 && ( errno == EAGAIN || errno == EWOULDBLOCK ) ) break;
+
+            // n == 0 또는 EIO: 자식 프로세스가 pty를 닫음 (종료)
+            CloseMaster();
+            ReapChild( false );
+            is_dirty_ = true;
+            break;
+        }
+
+        return total;
+    }
+
+    void TermPane::Feed( std::string_view data )
+    {
+        if( data.empty() ) return;
+
+        tokenizer_.Feed( data );
+
+        AnsiTokenizer::Token token;
+        while( tokenizer_.Next( token ) ) {
+            HandleToken( token );
+        }
+        is_dirty_ = true;
+    }
+
+    void TermPane::SendInput( std::string_view bytes )
+    {
+        if( master_fd_ < 0 ) return;
+
+        // 보기 위치가 과거에 있다면 입력 시 최신 화면으로 복귀
+        if( view_offset_ != 0 ) ResetView();
+
+        while( !bytes.empty() )
+        {
+            ssize_t n = write( master_fd_, bytes.data(), bytes.size() );
+            if( n > 0 ) {
+                bytes.remove_prefix( static_cast<size_t>( n ) );
+                continue;
+            }
+            if( n < 0 && errno == EINTR ) continue;
+            if( n < 0 && ( errno == EAGAIN || errno == EWOULDBLOCK ) ) {
+                // 자식이 입력을 읽을 때까지 잠시 대기 (최대 50ms)
+                struct pollfd pfd { master_fd_, POLLOUT, 0 };
+                if( poll( &pfd, 1, 50 ) > 0 ) continue;
+            }
+            break;
+        }
+    }
+
+    void TermPane::SendPaste( std::string_view text )
+    {
+        if( bracketed_paste_ ) SendInput( "\033[200~" );
+        SendInput( text );
+        if( bracketed_paste_ ) SendInput( "\033[201~" );
+    }
+
+    void TermPane::Reply( std::string_view bytes )
+    {
+        if( master_fd_ < 0 ) return;
+        ssize_t n = write( master_fd_, bytes.data(), bytes.size() ); (void)(n);
+    }
+
+    void TermPane::SendKey( DeviceInputCode key )
+    {
+        // 커서 키는 DECCKM(Application Cursor Keys) 모드에 따라 시퀀스가 다름
+        const char* csi = app_cursor_ ? "\033O" : "\033[";
+
+        switch( key )
+        {
+            case DeviceInputCode::ARROW_UP:    SendInput( std::string( csi ) + "A" ); return;
+            case DeviceInputCode::ARROW_DOWN:  SendInput( std::string( csi ) + "B" ); return;
+            case DeviceInputCode::ARROW_RIGHT: SendInput( std::string( csi ) + "C" ); return;
+            case DeviceInputCode::ARROW_LEFT:  SendInput( std::string( csi ) + "D" ); return;
+            case DeviceInputCode::HOME:        SendInput( std::string( csi ) + "H" ); return;
+            case DeviceInputCode::END:         SendInput( std::string( csi ) + "F" ); return;
+
+            case DeviceInputCode::INSERT:      SendInput( "\033[2~" ); return;
+            case DeviceInputCode::DEL:         SendInput( "\033[3~" ); return;
+            case DeviceInputCode::PAGE_UP:     SendInput( "\033[5~" ); return;
+            case DeviceInputCode::PAGE_DOWN:   SendInput( "\033[6~" ); return;
+
+            case DeviceInputCode::F1:  SendInput( "\033OP"   ); return;
+            case DeviceInputCode::F2:  SendInput( "\033OQ"   ); return;
+            case DeviceInputCode::F3:  SendInput( "\033OR"   ); return;
+            case DeviceInputCode::F4:  SendInput( "\033OS"   ); return;
+            case DeviceInputCode::F5:  SendInput( "\033[15~" ); return;
+            case DeviceInputCode::F6:  SendInput( "\033[17~" ); return;
+            case DeviceInputCode::F7:  SendInput( "\033[18~" ); return;
+            case DeviceInputCode::F8:  SendInput( "\033[19~" ); return;
+            case DeviceInputCode::F9:  SendInput( "\033[20~" ); return;
+            case DeviceInputCode::F10: SendInput( "\033[21~" ); return;
+            case DeviceInputCode::F11: SendInput( "\033[23~" ); return;
+            case DeviceInputCode::F12: SendInput( "\033[24~" ); return;
+
+            case DeviceInputCode::ENTER:     SendInput( "\r"   ); return;
+            case DeviceInputCode::BACKSPACE: SendInput( "\x7f" ); return;
+            default: break;
+        }
+
+        // 그 외 단일 바이트 코드 (ASCII, 제어 문자, UTF-8 바이트)
+        int code = static_cast<int>( key );
+        if( code >= 0 && code < 256 ) {
+            char c = static_cast<char>( code );
+            SendInput( std::string_view( &c, 1 ) );
+        }
+    }
+
+    void TermPane::SendKey( const Device::Event& event )
+    {
+        // 키를 뗀 이벤트는 보내지 않음 (kitty 키보드 프로토콜, 반복은 누름과 같이 처리)
+        if( event.IsRelease() ) return;
+
+        // ASCII 외 문자 : UTF-8로 그대로 전달
+        if( event.IsText() ) {
+            std::string utf8;
+            Util::AppendUtf8( utf8, event.codepoint );
+            if( event.mods & MOD_ALT ) utf8.insert( 0, 1, '\033' );
+            SendInput( utf8 );
+            return;
+        }
+
+        int     code = static_cast<int>( event.code );
+        uint8_t mods = event.mods;
+
+        if( mods == MOD_NONE ) { SendKey( event.code ); return; }
+
+        // 단일 바이트 키 : Ctrl은 제어 문자로, Alt는 ESC 접두로 표현
+        if( code >= 0 && code < 256 )
+        {
+            char c = static_cast<char>( code );
+            if( mods & MOD_CTRL ) {
+                if     ( code == ' ' )                   c = 0;
+                else if( code >= 'a' && code <= 'z' )    c = static_cast<char>( code - 'a' + 1 );
+                else if( code >= '@' && code <= '_' )    c = static_cast<char>( code - '@' );
+            }
+
+            std::string seq;
+            if( mods & MOD_ALT ) seq += '\033';
+            if( event.code == DeviceInputCode::TAB && ( mods & MOD_SHIFT ) ) seq += "\033[Z";
+            else if( event.code == DeviceInputCode::ENTER ) seq += '\r';
+            else seq += c;
+            SendInput( seq );
+            return;
+        }
+
+        // 특수 키 : xterm 수식 키 파라미터 (1 + Shift:1 | Alt:2 | Ctrl:4)
+        //   ESC [ 1 ; m X  (화살표, Home/End, F1 ~ F4)  /  ESC [ n ; m ~  (편집 키, F5 ~ F12)
+        const char* letter = nullptr;
+        const char* number = nullptr;
+        switch( event.code )
+        {
+            case DeviceInputCode::ARROW_UP:    letter = "A"; break;
+            case DeviceInputCode::ARROW_DOWN:  letter = "B"; break;
+            case DeviceInputCode::ARROW_RIGHT: letter = "C"; break;
+            case DeviceInputCode::ARROW_LEFT:  letter = "D"; break;
+            case DeviceInputCode::HOME:        letter = "H"; break;
+            case DeviceInputCode::END:         letter = "F"; break;
+            case DeviceInputCode::F1:          letter = "P"; break;
+            case DeviceInputCode::F2:          letter = "Q"; break;
+            case DeviceInputCode::F3:          letter = "R"; break;
+            case DeviceInputCode::F4:          letter = "S"; break;
+
+            case DeviceInputCode::INSERT:      number = "2";  break;
+            case DeviceInputCode::DEL:         number = "3";  break;
+            case DeviceInputCode::PAGE_UP:     number = "5";  break;
+            case DeviceInputCode::PAGE_DOWN:   number = "6";  break;
+            case DeviceInputCode::F5:          number = "15"; break;
+            case DeviceInputCode::F6:          number = "17"; break;
+            case DeviceInputCode::F7:          number = "18"; break;
+            case DeviceInputCode::F8:          number = "19"; break;
+            case DeviceInputCode::F9:          number = "20"; break;
+            case DeviceInputCode::F10:         number = "21"; break;
+            case DeviceInputCode::F11:         number = "23"; break;
+            case DeviceInputCode::F12:         number = "24"; break;
+            default: SendKey( event.code ); return;
+        }
+
+        std::string param = std::to_string( 1 + ( mods & ( MOD_SHIFT | MOD_ALT | MOD_CTRL ) ) );
+        if( letter ) SendInput( "\033[1;" + param + letter );
+        else         SendInput( std::string( "\033[" ) + number + ";" + param + "~" );
+    }
+
+    // =========================================================================
+    // View
+    // =========================================================================
+
+    void TermPane::Resize( int cols, int rows )
+    {
+        cols = std::max( cols, 1 );
+        rows = std::max( rows, 1 );
+        if( cols == cols_ && rows == rows_ ) return;
+
+        // 줄 수가 줄어들 때 커서가 화면 밖으로 나가면, 위쪽 줄을 스크롤백으로 밀어냄
+        if( cur_y_ >= rows ) {
+            int shift = cur_y_ - rows + 1;
+            ScrollUp( 0, rows_ - 1, shift, !is_alt_screen_ );
+            cur_y_ -= shift;
+        }
+
+        ResizeGrid( screen_, cols, rows );
+        if( !alt_screen_.empty() ) ResizeGrid( alt_screen_, cols, rows );
+
+        cols_ = cols;
+        rows_ = rows;
+
+        scroll_top_    = 0;
+        scroll_bottom_ = rows_ - 1;
+        cur_x_ = std::min( cur_x_, cols_ - 1 );
+        cur_y_ = std::min( cur_y_, rows_ - 1 );
+        wrap_pending_ = false;
+        view_offset_  = std::min( view_offset_, (int)history_count_ );
+
+        if( master_fd_ >= 0 ) {
+            struct winsize ws {};
+            ws.ws_col = static_cast<unsigned short>( cols_ );
+            ws.ws_row = static_cast<unsigned short>( rows_ );
+            ioctl( master_fd_, TIOCSWINSZ, &ws ); // 자식 프로세스에 SIGWINCH 전달됨
+        }
+        is_dirty_ = true;
+    }
+
+    void TermPane::ResizeGrid( std::vector<Row>& grid, int cols, int rows )
+    {
+        grid.resize( rows );
+        for( auto& row : grid ) {
+            if( row.empty() ) ClearRow( row );
+            row.resize( cols, BlankCell() );
+        }
+    }
+
+    void TermPane::ScrollView( int lines )
+    {
+        int next = std::clamp( view_offset_ + lines, 0, (int)history_count_ );
+        if( next == view_offset_ ) return;
+
+        view_offset_ = next;
+        is_dirty_ = true;
+    }
+
+    void TermPane::Render( Buffer& buffer, int x, int y )
+    {
+        const Cell blank = Cell{};
+
+        for( int r = 0; r < rows_; ++r )
+        {
+            // 보기 위치에 따라 스크롤백 줄 또는 현재 화면 줄을 선택
+            const Row* row = nullptr;
+            int line = (int)history_count_ - view_offset_ + r;
+            if( line < (int)history_count_ ) row = &HistoryAt( line );
+            else                             row = &screen_[line - history_count_];
+
+            for( int c = 0; c < cols_; ++c ) {
+                const Cell& cell = ( c < (int)row->size() ) ? (*row)[c] : blank;
+                buffer.SetCell( x + c, y + r, cell );
+            }
+        }
+
+        // 커서 표시 (반전)
+        if( cursor_visible_ && view_offset_ == 0 && pid_ > 0 ) {
+            Cell cursor = screen_[cur_y_][cur_x_];
+            if( cursor.is_wide_trail ) {
+                cursor.ch = " ";
+                cursor.is_wide_trail = false;
+                cursor.width = 1;
+            }
+            cursor.attr ^= ATTR_REVERSE;
+            buffer.SetCell( x + cur_x_, y + cur_y_, cursor );
+        }
+
+        is_dirty_ = false;
+    }
+
+    // =========================================================================
+    // Scrollback Ring Buffer
+    // =========================================================================
+
+    /**
+     * @brief 화면 위로 밀려난 줄을 스크롤백에 보관합니다.
+     * @param row [in/out] 보관할 줄. 호출 후에는 재사용 가능한 (내용 미정의) 줄이 들어있음
+     *
+     * @details
+     *   링 버퍼가 가득 차면 가장 오래된 줄과 교환(swap)하므로,
+     *   안정 상태에서는 줄 단위 메모리 할당이 발생하지 않습니다.
+     */
+    void TermPane::PushHistory( Row& row )
+    {
+        if( history_limit_ == 0 ) return;
+
+        if( history_.size() < history_limit_ ) {
+            history_.emplace_back();
+            history_.back().swap( row );
+            history_count_ = history_.size();
+        }
+        else {
+            Row& oldest = history_[history_head_];
+            oldest.swap( row );
+            history_head_ = ( history_head_ + 1 ) % history_limit_;
+        }
+
+        // 과거를 보고 있는 중이라면 보던 위치를 유지
+        if( view_offset_ > 0 ) view_offset_ = std::min( view_offset_ + 1, (int)history_count_ );
+    }
+
+    const TermPane::Row& TermPane::HistoryAt( size_t index ) const
+    {
+        return history_[( history_head_ + index ) % history_.size()];
+    }
+
+    // =========================================================================
+    // Screen Operations
+    // =========================================================================
+
+    Cell TermPane::BlankCell( void ) const
+    {
+        // 지워진 칸은 현재 배경색을 사용 (BCE: Background Color Erase)
+        Cell cell;
+        cell.fg = base_style_.fg;
+        cell.bg = style_.bg;
+        return cell;
+    }
+
+    void TermPane::ClearRow( Row& row )
+    {
+        row.assign( cols_, BlankCell() );
+    }
+
+    void TermPane::EraseCells( int y, int from, int to )
+    {
+        from = std::max( from, 0 );
+        to   = std::min( to, cols_ );
+
+        Cell blank = BlankCell();
+        for( int x = from; x < to; ++x ) screen_[y][x] = blank;
+    }
+
+    void TermPane::SetCursor( int x, int y )
+    {
+        cur_x_ = std::clamp( x, 0, cols_ - 1 );
+        cur_y_ = std::clamp( y, 0, rows_ - 1 );
+        wrap_pending_ = false;
+    }
+
+    void TermPane::ScrollUp( int top, int bottom, int count, bool to_history )
+    {
+        count = std::min( count, bottom - top + 1 );
+
+        for( int i = 0; i < count; ++i ) {
+            if( to_history ) PushHistory( screen_[top] );
+            std::rotate( screen_.begin() + top, screen_.begin() + top + 1, screen_.begin() + bottom + 1 );
+            ClearRow( screen_[bottom] );
+        }
+    }
+
+    bool TermPane::ScrollsToHistory( void ) const
+    {
+        // 주 화면 맨 위에서 밀려나는 줄만 스크롤백에 보관
+        return scroll_top_ == 0 && !is_alt_screen_;
+    }
+
+    void TermPane::ScrollDown( int top, int bottom, int count )
+    {
+        count = std::min( count, bottom - top + 1 );
+
+        for( int i = 0; i < count; ++i ) {
+            std::rotate( screen_.begin() + top, screen_.begin() + bottom, screen_.begin() + bottom + 1 );
+            ClearRow( screen_[top] );
+        }
+    }
+
+    void TermPane::LineFeed( void )
+    {
+        if     ( cur_y_ == scroll_bottom_ ) ScrollUp( scroll_top_, scroll_bottom_, 1, ScrollsToHistory() );
+        else if( cur_y_ < rows_ - 1 )       cur_y_++;
+        wrap_pending_ = false;
+    }
+
+    void TermPane::ReverseIndex( void )
+    {
+        if     ( cur_y_ == scroll_top_ ) ScrollDown( scroll_top_, scroll_bottom_, 1 );
+        else if( cur_y_ > 0 )            cur_y_--;
+        wrap_pending_ = false;
+    }
+
+    void TermPane::SwitchAltScreen( bool enable )
+    {
+        if( enable == is_alt_screen_ ) return;
+
+        if( enable ) {
+            alt_screen_.swap( screen_ );
+            screen_.assign( rows_, Row() );
+            for( auto& row : screen_ ) ClearRow( row );
+        }
+        else {
+            screen_.swap( alt_screen_ );
+            alt_screen_.clear();
+        }
+        is_alt_screen_ = enable;
+        scroll_top_    = 0;
+        scroll_bottom_ = rows_ - 1;
+    }
+
+    // =========================================================================
+    // VT Parser Actions
+    // =========================================================================
+
+    void TermPane::HandleToken( const AnsiTokenizer::Token& token )
+    {
+        // 텍스트가 아닌 토큰이 오면 미완성 UTF-8 조각은 버림
+        if( token.type != AnsiTokenizer::TokenType::TEXT ) utf8_carry_len_ = 0;
+
+        switch( token.type )
+        {
+            case AnsiTokenizer::TokenType::TEXT:    PrintRun( token.raw );           break;
+            case AnsiTokenizer::TokenType::CONTROL: HandleControl( token.final_ch ); break;
+            case AnsiTokenizer::TokenType::ESC:     HandleEsc( token );              break;
+            case AnsiTokenizer::TokenType::CSI:     HandleCsi( token );              break;
+
+            case AnsiTokenizer::TokenType::OSC:
+                // OSC 0 / 2 : 창 제목
+                if( token.payload.size() >= 2 && ( token.payload[0] == '0' || token.payload[0] == '2' ) &&
+                    token.payload[1] == ';' ) {
+                    title_.assign( token.payload.substr( 2 ) );
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    void TermPane::HandleControl( char c )
+    {
+        switch( c )
+        {
+            case '\r': cur_x_ = 0; wrap_pending_ = false; break;
+            case '\n': case '\v': case '\f': LineFeed(); break;
+            case '\b':
+                if( cur_x_ > 0 ) cur_x_--;
+                wrap_pending_ = false;
+                break;
+            case '\t':
+                cur_x_ = std::min( ( cur_x_ / 8 + 1 ) * 8, cols_ - 1 );
+                wrap_pending_ = false;
+                break;
+            default: break; // BEL 등은 무시
+        }
+    }
+
+    void TermPane::HandleEsc( const AnsiTokenizer::Token& token )
+    {
+        // 문자셋 지정 등 중간 문자가 있는 시퀀스는 무시 (ESC ( B 등)
+        if( token.intermediate[0] != 0 ) return;
+
+        switch( token.final_ch )
+        {
+            case '7': saved_cursor_ = { cur_x_, cur_y_, style_ }; break;                       // DECSC
+            case '8': SetCursor( saved_cursor_.x, saved_cursor_.y ); style_ = saved_cursor_.style; break; // DECRC
+            case 'D': LineFeed(); break;                                                         // IND
+            case 'E': cur_x_ = 0; LineFeed(); break;                                             // NEL
+            case 'M': ReverseIndex(); break;                                                     // RI
+            case 'c':                                                                            // RIS
+                SwitchAltScreen( false );
+                style_ = base_style_;
+                for( auto& row : screen_ ) ClearRow( row );
+                SetCursor( 0, 0 );
+                scroll_top_ = 0;
+                scroll_bottom_ = rows_ - 1;
+                autowrap_ = true;
+                insert_mode_ = false;
+                app_cursor_ = false;
+                cursor_visible_ = true;
+                break;
+            default: break;
+        }
+    }
+
+    void TermPane::HandleCsi( const AnsiTokenizer::Token& token )
+    {
+        // 대부분의 파라미터는 0 또는 생략 시 1로 취급
+        auto Count = [&]( size_t idx ) { return std::max( token.Param( idx, 1 ), 1 ); };
+
+        if( token.prefix == '?' ) {
+            if( token.final_ch == 'h' ) HandleMode( token, true );
+            if( token.final_ch == 'l' ) HandleMode( token, false );
+            return;
+        }
+
+        // '>' 등 다른 Private Marker는 DA2만 응답
+        if( token.prefix != 0 ) {
+            if( token.prefix == '>' && token.final_ch == 'c' ) Reply( "\033[>0;0;0c" );
+            return;
+        }
+
+        // 중간 문자가 있는 시퀀스 (DECSCUSR 등)는 무시
+        if( token.intermediate[0] != 0 ) return;
+
+        switch( token.final_ch )
+        {
+            // --- Cursor Movement ---
+            case 'A': SetCursor( cur_x_, std::max( cur_y_ - Count( 0 ), cur_y_ >= scroll_top_ ? scroll_top_ : 0 ) ); break;
+            case 'B': SetCursor( cur_x_, std::min( cur_y_ + Count( 0 ), cur_y_ <= scroll_bottom_ ? scroll_bottom_ : rows_ - 1 ) ); break;
+            case 'C': SetCursor( cur_x_ + Count( 0 ), cur_y_ ); break;
+            case 'D': SetCursor( cur_x_ - Count( 0 ), cur_y_ ); break;
+            case 'E': SetCursor( 0, cur_y_ + Count( 0 ) ); break;
+            case 'F': SetCursor( 0, cur_y_ - Count( 0 ) ); break;
+            case 'G': case '`': SetCursor( Count( 0 ) - 1, cur_y_ ); break;
+            case 'd': SetCursor( cur_x_, Count( 0 ) - 1 ); break;
+            case 'H': case 'f': SetCursor( Count( 1 ) - 1, Count( 0 ) - 1 ); break;
+            case 's': saved_cursor_ = { cur_x_, cur_y_, style_ }; break;
+            case 'u': SetCursor( saved_cursor_.x, saved_cursor_.y ); style_ = saved_cursor_.style; break;
+
+            // --- Erase ---
+            case 'J':
+                switch( token.Param( 0 ) ) {
+                    case 0:
+                        EraseCells( cur_y_, cur_x_, cols_ );
+                        for( int y = cur_y_ + 1; y < rows_; ++y ) ClearRow( screen_[y] );
+                        break;
+                    case 1:
+                        for( int y = 0; y < cur_y_; ++y ) ClearRow( screen_[y] );
+                        EraseCells( cur_y_, 0, cur_x_ + 1 );
+                        break;
+                    case 2:
+                        for( auto& row : screen_ ) ClearRow( row );
+                        break;
+                    case 3:
+                        history_.clear();
+                        history_head_  = 0;
+                        history_count_ = 0;
+                        view_offset_   = 0;
+                        break;
+                }
+                break;
+
+            case 'K':
+                switch( token.Param( 0 ) ) {
+                    case 0: EraseCells( cur_y_, cur_x_, cols_ );     break;
+                    case 1: EraseCells( cur_y_, 0, cur_x_ + 1 );     break;
+                    case 2: EraseCells( cur_y_, 0, cols_ );          break;
+                }
+                break;
+
+            case 'X': EraseCells( cur_y_, cur_x_, cur_x_ + Count( 0 ) ); break;
+
+            // --- Insert / Delete ---
+            case '@': {
+                Row& row = screen_[cur_y_];
+                int n = std::min( Count( 0 ), cols_ - cur_x_ );
+                std::rotate( row.begin() + cur_x_, row.end() - n, row.end() );
+                EraseCells( cur_y_, cur_x_, cur_x_ + n );
+                break;
+            }
+            case 'P': {
+                Row& row = screen_[cur_y_];
+                int n = std::min( Count( 0 ), cols_ - cur_x_ );
+                std::rotate( row.begin() + cur_x_, row.begin() + cur_x_ + n, row.end() );
+                EraseCells( cur_y_, cols_ - n, cols_ );
+                break;
+            }
+            case 'L':
+                if( cur_y_ >= scroll_top_ && cur_y_ <= scroll_bottom_ ) {
+                    ScrollDown( cur_y_, scroll_bottom_, Count( 0 ) );
+                    cur_x_ = 0;
+                }
+                break;
+            case 'M':
+                if( cur_y_ >= scroll_top_ && cur_y_ <= scroll_bottom_ ) {
+                    // 스크롤 영역 중간에서 지워지는 줄은 스크롤백에 넣지 않음
+                    ScrollUp( cur_y_, scroll_bottom_, Count( 0 ), false );
+                    cur_x_ = 0;
+                }
+                break;
+
+            // --- Scroll ---
+            case 'S': ScrollUp( scroll_top_, scroll_bottom_, Count( 0 ), ScrollsToHistory() ); break;
+            case 'T': ScrollDown( scroll_top_, scroll_bottom_, Count( 0 ) ); break;
+            case 'r': {
+                int top    = Count( 0 ) - 1;
+                int bottom = token.Param( 1, rows_ ) - 1;
+                bottom = std::clamp( bottom, 0, rows_ - 1 );
+                if( top < bottom ) {
+                    scroll_top_    = top;
+                    scroll_bottom_ = bottom;
+                    SetCursor( 0, 0 );
+                }
+                break;
+            }
+
+            // --- Attributes & Modes ---
+            case 'm': Buffer::ApplySgr( token, style_, base_style_ ); break;
+            case 'h': if( token.Param( 0 ) == 4 ) insert_mode_ = true;  break;
+            case 'l': if( token.Param( 0 ) == 4 ) insert_mode_ = false; break;
+
+            // --- Reports ---
+            case 'n':
+                if( token.Param( 0 ) == 5 ) Reply( "\033[0n" );
+                if( token.Param( 0 ) == 6 ) {
+                    Reply( "\033[" + std::to_string( cur_y_ + 1 ) + ";" + std::to_string( cur_x_ + 1 ) + "R" );
+                }
+                break;
+            case 'c': Reply( "\033[?1;2c" ); break; // DA1: VT100 with AVO
+
+            default: break;
+        }
+    }
+
+    void TermPane::HandleMode( const AnsiTokenizer::Token& token, bool enable )
+    {
+        for( size_t i = 0; i < token.param_count; ++i )
+        {
+            switch( token.Param( i ) )
+            {
+                case 1:    app_cursor_      = enable; break; // DECCKM
+                case 7:    autowrap_        = enable; break; // DECAWM
+                case 25:   cursor_visible_  = enable; break; // DECTCEM
+                case 2004: bracketed_paste_ = enable; break;
+
+                case 47:
+                case 1047:
+                    SwitchAltScreen( enable );
+                    break;
+
+                case 1049:
+                    // 커서 저장 + 대체 화면 (vim, less 등)
+                    if( enable ) {
+                        saved_cursor_ = { cur_x_, cur_y_, style_ };
+                        SwitchAltScreen( true );
+                    } else {
+                        SwitchAltScreen( false );
+                        SetCursor( saved_cursor_.x, saved_cursor_.y );
+                        style_ = saved_cursor_.style;
+                    }
+                    break;
+
+                default: break; // 마우스 보고 모드 등은 지원하지 않음
+            }
+        }
+    }
+
+    void TermPane::PrintRun( std::string_view run )
+    {
+        size_t i   = 0;
+        size_t len = run.length();
+
+        // 이전 Feed()에서 잘린 UTF-8 문자 이어붙이기
+        if( utf8_carry_len_ > 0 ) {
+            size_t need = Util::GetUtf8SeqLength( static_cast<unsigned char>( utf8_carry_[0] ) );
+            while( utf8_carry_len_ < need && i < len &&
+                   ( static_cast<unsigned char>( run[i] ) & 0xC0 ) == 0x80 ) {
+                utf8_carry_[utf8_carry_len_++] = run[i++];
+            }
+            if( utf8_carry_len_ < need && i == len ) return; // 아직 미완성
+
+            uint32_t cp = 0;
+            int n = Util::DecodeUtf8( utf8_carry_, utf8_carry_len_, cp );
+            PrintChar( utf8_carry_, n, cp );
+            utf8_carry_len_ = 0;
+        }
+
+        while( i < len ) {
+            // 입력 끝에서 잘린 문자는 다음 Feed()까지 보관
+            size_t need = Util::GetUtf8SeqLength( static_cast<unsigned char>( run[i] ) );
+            if( i + need > len ) {
+                utf8_carry_len_ = len - i;
+                std::copy( run.begin() + i, run.end(), utf8_carry_ );
+                return;
+            }
+
+            uint32_t cp = 0;
+            int n = Util::DecodeUtf8( run.data() + i, len - i, cp );
+            PrintChar( run.data() + i, n, cp );
+            i += n;
+        }
+    }
+
+    void TermPane::PrintChar( const char* bytes, size_t len, uint32_t codepoint )
+    {
+        // 잘못된 UTF-8 시퀀스는 대체 문자(U+FFFD)로 표시
+        if( codepoint == 0 ) {
+            bytes = "\xEF\xBF\xBD";
+            len = 3;
+            codepoint = 0xFFFD;
+        }
+
+        int width = Util::GetCharWidth( codepoint );
+
+        // 결합 문자는 직전에 출력한 칸에 덧붙임
+        if( width == 0 ) {
+            int x = wrap_pending_ ? cur_x_ : cur_x_ - 1;
+            if( x >= 0 && screen_[cur_y_][x].is_wide_trail ) x--;
+            if( x >= 0 ) screen_[cur_y_][x].ch.append( bytes, len );
+            return;
+        }
+
+        // 지연된 줄바꿈 (마지막 칸에 출력한 뒤 다음 문자가 올 때 줄바꿈)
+        if( wrap_pending_ && autowrap_ ) {
+            cur_x_ = 0;
+            LineFeed();
+        }
+        wrap_pending_ = false;
+
+        // 2칸 문자가 마지막 칸에 걸리면 다음 줄로 넘김
+        if( width == 2 && cur_x_ == cols_ - 1 ) {
+            if( !autowrap_ ) return;
+            EraseCells( cur_y_, cur_x_, cols_ );
+            cur_x_ = 0;
+            LineFeed();
+        }
+
+        Row& row = screen_[cur_y_];
+
+        if( insert_mode_ ) {
+            int n = std::min( width, cols_ - cur_x_ );
+            std::rotate( row.begin() + cur_x_, row.end() - n, row.end() );
+        }
+
+        // 2칸 문자의 절반을 덮어쓰는 경우, 남은 절반을 공백으로 정리
+        if( row[cur_x_].is_wide_trail && cur_x_ > 0 ) row[cur_x_ - 1] = BlankCell();
+        int end_x = cur_x_ + width;
+        if( end_x < cols_ && row[end_x].is_wide_trail ) row[end_x] = BlankCell();
+
+        Cell& cell = row[cur_x_];
+        cell.ch.assign( bytes, len );
+        cell.fg = style_.fg;
+        cell.bg = style_.bg;
+        cell.attr = style_.attr;
+        cell.is_wide_trail = false;
+        cell.width = static_cast<uint8_t>( width );
+
+        if( width == 2 && cur_x_ + 1 < cols_ ) {
+            Cell& trail = row[cur_x_ + 1];
+            trail.ch.clear();
+            trail.fg = style_.fg;
+            trail.bg = style_.bg;
+            trail.attr = style_.attr;
+            trail.is_wide_trail = true;
+            trail.width = 0;
+        }
+
+        cur_x_ += width;
+        if( cur_x_ >= cols_ ) {
+            cur_x_ = cols_ - 1;
+            wrap_pending_ = autowrap_;
+        }
+    }
+
+} // namespace cx
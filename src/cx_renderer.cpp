@@ -0,0 +1,88 @@
+#include "cx_renderer.hpp"
+#include "cx_screen.hpp"
+
+// System Headers
+#include <utility>     // std::swap
+
+namespace cx
+{
+    Renderer::Renderer( void )
+    {
+        writer_ = std::thread( &Renderer::WriterLoop, this );
+    }
+
+    Renderer::~Renderer()
+    {
+        Stop();
+    }
+
+    void Renderer::Submit( void )
+    {
+        uint8_t submitted = app_index_;
+        int     width     = slots_[submitted].GetWidth();
+        int     height    = slots_[submitted].GetHeight();
+
+        // 그린 버퍼를 중간에 두고, 중간에 있던 버퍼를 받아 옴
+        uint8_t prev = middle_.exchange( app_index_ | FRESH_BIT, std::memory_order_acq_rel );
+        if( prev & FRESH_BIT ) dropped_frames_.fetch_add( 1, std::memory_order_relaxed ); // Writer가 가져가기 전에 대체됨
+
+        app_index_ = prev & INDEX_MASK;
+        slots_[app_index_].Resize( width, height );
+        slots_[app_index_].CopyFlushOptions( slots_[submitted] ); // GetBuffer()에 설정한 출력 옵션 유지
+
+        submit_seq_.fetch_add( 1, std::memory_order_release );
+        submit_seq_.notify_one();
+    }
+
+    void Renderer::Stop( void )
+    {
+        if( !writer_.joinable() ) return;
+
+        stop_.store( true, std::memory_order_release );
+        submit_seq_.fetch_add( 1, std::memory_order_release );
+        submit_seq_.notify_one();
+
+        writer_.join();
+
+        // Writer는 멈출 때 남은 출력을 기다리지 않으므로 여기서 마저 씀 (이후 호출 측이 직접 출력할 수 있도록)
+        Screen::DrainOutput( SHUTDOWN_DRAIN_TIMEOUT );
+    }
+
+    void Renderer::WriterLoop( void )
+    {
+        uint32_t seen = submit_seq_.load( std::memory_order_acquire );
+
+        for( ;; )
+        {
+            if( middle_.load( std::memory_order_acquire ) & FRESH_BIT )
+            {
+                // 최신 프레임을 가져오고, 출력이 끝난 버퍼를 중간에 돌려줌 (FRESH_BIT 해제)
+                uint8_t prev  = middle_.exchange( writer_index_, std::memory_order_acq_rel );
+                writer_index_ = prev & INDEX_MASK;
+
+                Buffer& frame = slots_[writer_index_];
+                screen_.Resize( frame.width_, frame.height_ ); // 크기가 바뀌었으면 전체 다시 그리기
+
+                std::swap( screen_.back_buffer_, frame.back_buffer_ );
+                std::swap( screen_.back_hash_, frame.back_hash_ );
+                screen_.CopyFlushOptions( frame ); // 앱이 GetBuffer()에 설정한 출력 옵션을 따름
+                screen_.Flush();
+                scrolled_frames_.store( screen_.GetScrolledFrames(), std::memory_order_relaxed );
+
+                // 전용 스레드이므로 남은 출력은 여기서 기다리며 씀 (그동안 제출된 프레임은 최신 것만 남음)
+                while( !Screen::DrainOutput( std::chrono::milliseconds( 100 ) ) ) {
+                    if( stop_.load( std::memory_order_acquire ) ) break;
+                }
+
+                written_frames_.fetch_add( 1, std::memory_order_relaxed );
+                continue; // 출력하는 동안 제출된 프레임이 있으면 바로 이어서 처리
+            }
+
+            if( stop_.load( std::memory_order_acquire ) ) break;
+
+            submit_seq_.wait( seen, std::memory_order_acquire );
+            seen = submit_seq_.load( std::memory_order_acquire );
+        }
+    }
+
+} // namespace cx
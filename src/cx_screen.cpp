@@ -1,10 +1,15 @@
 #include "cx_screen.hpp"
+#include "cx_caps.hpp"
 
 // System Headers
 #include <sys/ioctl.h> // ioctl, TIOCGWINSZ
-#include <unistd.h>    // STDOUT_FILENO
+#include <fcntl.h>     // open, O_NONBLOCK
+#include <poll.h>      // poll
+#include <unistd.h>    // STDOUT_FILENO, write, isatty, ttyname
+#include <cerrno>
 #include <algorithm>   // std::clamp
 #include <iostream>
+#include <mutex>
 
 namespace cx
 {
@@ -72,7 +77,7 @@ namespace cx
 
         // 핵심: User(0-based) -> ANSI(1-based) 변환
         // \033[<Row>;<Col>H
-        std::cout << "\033[" << safe_pos.y + 1 << ";" << safe_pos.x + 1 << "H" << std::flush;
+        Write( "\033[" + std::to_string( safe_pos.y + 1 ) + ";" + std::to_string( safe_pos.x + 1 ) + "H" );
 
         return true;
     }
@@ -84,19 +89,20 @@ namespace cx
         // 상대 이동 명령은 터미널 에뮬레이터가 알아서 화면 끝 처리를 하므로
         // 별도의 Clamp 로직 없이 명령만 전송합니다.
 
-        if( dy < 0 ) std::cout << "\033[" << -dy << "A"; // Up
-        if( dy > 0 ) std::cout << "\033[" <<  dy << "B"; // Down
-        if( dx > 0 ) std::cout << "\033[" <<  dx << "C"; // Right
-        if( dx < 0 ) std::cout << "\033[" << -dx << "D"; // Left
+        std::string seq;
+        if( dy < 0 ) seq += "\033[" + std::to_string( -dy ) + "A"; // Up
+        if( dy > 0 ) seq += "\033[" + std::to_string(  dy ) + "B"; // Down
+        if( dx > 0 ) seq += "\033[" + std::to_string(  dx ) + "C"; // Right
+        if( dx < 0 ) seq += "\033[" + std::to_string( -dx ) + "D"; // Left
 
-        std::cout << std::flush;
+        Write( seq );
     }
 
     void Screen::Clear( void )
     {
         // \033[2J: 화면 전체 지우기
         // \033[1;1H: 커서를 좌상단(1,1)으로 이동
-        std::cout << "\033[2J\033[1;1H" << std::flush;
+        Write( "\033[2J\033[1;1H" );
     }
 
     bool Screen::SetColor( const Color& color )
@@ -105,7 +111,7 @@ namespace cx
             return false;
 
         // Color 객체로부터 전경색 ANSI 코드를 받아 출력
-        std::cout << color.ToAnsiForeground() << std::flush;
+        Write( color.ToAnsiForeground( Capabilities::Current()->color_depth ) );
 
         return true;
     }
@@ -116,7 +122,7 @@ namespace cx
             return false;
 
         // Color 객체로부터 배경색 ANSI 코드를 받아 출력
-        std::cout << color.ToAnsiBackground() << std::flush;
+        Write( color.ToAnsiBackground( Capabilities::Current()->color_depth ) );
 
         return true;
     }
@@ -124,7 +130,118 @@ namespace cx
     void Screen::ResetColor( void )
     {
         // Color::Reset 객체의 코드를 출력 (\033[0m)
-        std::cout << Color::Reset.ToAnsiForeground() << std::flush;
+        Write( Color::Reset.ToAnsiForeground() );
+    }
+
+    // =========================================================================
+    // Terminal Output Queue
+    // =========================================================================
+
+    // 아직 터미널에 쓰지 못한 출력 (offset부터, 프로세스 공용)
+    // 종료 중(전역 소멸자 등)에도 쓸 수 있도록 해제하지 않습니다.
+    struct OutputQueue
+    {
+        std::mutex  mtx;
+        std::string pending;
+        size_t      offset = 0;
+    };
+
+    static OutputQueue& GetOutputQueue( void )
+    {
+        static OutputQueue* queue = new OutputQueue();
+        return *queue;
+    }
+
+    // [Internal Helper] 화면 출력용 Non-Blocking fd
+    // STDOUT에 O_NONBLOCK을 걸면 같은 터미널을 공유하는 부모 셸과 STDIN까지 넌블로킹이 되므로,
+    // 터미널을 따로 열어 이 fd에만 O_NONBLOCK을 겁니다. (터미널이 아니면 STDOUT에 블로킹으로 출력)
+    static int GetOutputFd( void )
+    {
+        static const int fd = []() {
+            const char* name = isatty( STDOUT_FILENO ) ? ttyname( STDOUT_FILENO ) : nullptr;
+            int opened = name ? open( name, O_WRONLY | O_NONBLOCK | O_NOCTTY | O_CLOEXEC ) : -1;
+            return opened != -1 ? opened : STDOUT_FILENO;
+        }();
+        return fd;
+    }
+
+    // [Internal Helper] 터미널이 받는 만큼 씁니다. (쓴 바이트 수, 쓸 수 없는 상태면 전부 쓴 것으로 보고 버림)
+    static size_t WriteSome( std::string_view data )
+    {
+        size_t written = 0;
+        while( written < data.size() ) {
+            ssize_t n = write( GetOutputFd(), data.data() + written, data.size() - written );
+            if( n > 0 ) { written += static_cast<size_t>( n ); continue; }
+            if( n < 0 && errno == EINTR ) continue;
+            if( n < 0 && ( errno == EAGAIN || errno == EWOULDBLOCK ) ) break; // 터미널이 느림: 나머지는 다음에
+
+            // 쓸 수 없는 상태 (터미널 닫힘 등)
+            return data.size();
+        }
+        return written;
+    }
+
+    // [Internal Helper] 큐에 남은 출력을 이어서 씁니다. (queue.mtx 보유 상태에서 호출, 모두 썼으면 true)
+    static bool WritePending( OutputQueue& queue )
+    {
+        if( queue.offset < queue.pending.size() ) {
+            queue.offset += WriteSome( std::string_view( queue.pending ).substr( queue.offset ) );
+            if( queue.offset < queue.pending.size() ) return false;
+        }
+
+        queue.pending.clear();
+        queue.offset = 0;
+        return true;
+    }
+
+    void Screen::Write( std::string_view data )
+    {
+        if( data.empty() ) return;
+
+        auto& queue = GetOutputQueue();
+        std::lock_guard<std::mutex> lock( queue.mtx );
+
+        // 남은 출력이 없으면 바로 쓰고, 터미널이 받지 못한 나머지만 보관
+        if( WritePending( queue ) ) {
+            std::cout.flush(); // 앱이 std::cout에 먼저 쓴 출력이 앞서도록 (남은 출력이 없을 때만 안전)
+            data.remove_prefix( WriteSome( data ) );
+            if( data.empty() ) return;
+        }
+        queue.pending.append( data );
+    }
+
+    bool Screen::FlushOutput( void )
+    {
+        auto& queue = GetOutputQueue();
+        std::lock_guard<std::mutex> lock( queue.mtx );
+        return WritePending( queue );
+    }
+
+    bool Screen::HasPendingOutput( void )
+    {
+        return GetPendingOutput() > 0;
+    }
+
+    size_t Screen::GetPendingOutput( void )
+    {
+        auto& queue = GetOutputQueue();
+        std::lock_guard<std::mutex> lock( queue.mtx );
+        return queue.pending.size() - queue.offset;
+    }
+
+    bool Screen::DrainOutput( std::chrono::milliseconds timeout )
+    {
+        // 터미널이 받을 수 있을 때마다 이어서 씀 (timeout까지, 한 번에 다 받지 못하는 느린 터미널 대비)
+        // 기다리는 동안에는 큐를 잠그지 않으므로, 다른 스레드의 Write()는 막히지 않고 뒤에 붙음
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while( !FlushOutput() ) {
+            auto left = std::chrono::ceil<std::chrono::milliseconds>( deadline - std::chrono::steady_clock::now() ).count();
+            if( left <= 0 ) return false;
+
+            struct pollfd pfd = { GetOutputFd(), POLLOUT, 0 };
+            if( poll( &pfd, 1, static_cast<int>( left ) ) < 0 && errno != EINTR ) return false;
+        }
+        return true;
     }
 
 } // namespace cx
\ No newline at end of file
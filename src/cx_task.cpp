@@ -0,0 +1,264 @@
+#include "cx_task.hpp"
+
+// System Headers
+#include <algorithm>   // std::max
+
+namespace cx
+{
+    // =========================================================================
+    // Awaiters
+    // =========================================================================
+
+    bool EventLoop::EventAwaiter::await_ready( void )
+    {
+        auto& pending = loop.pending_events_;
+        if( pending.empty() ) return false;
+
+        event    = std::move( pending.front() );
+        received = true;
+        pending.pop_front();
+        return true;
+    }
+
+    void EventLoop::EventAwaiter::await_suspend( std::coroutine_handle<> h )
+    {
+        handle        = h;
+        event_it      = loop.event_waiters_.insert( loop.event_waiters_.end(), this );
+        waiting_event = true;
+    }
+
+    bool EventLoop::TimedEventAwaiter::await_ready( void )
+    {
+        auto& pending = loop.pending_events_;
+        if( !pending.empty() ) {
+            event    = std::move( pending.front() );
+            received = true;
+            pending.pop_front();
+            return true;
+        }
+        return deadline <= Clock::now(); // 이미 지난 시간: 기다리지 않고 nullopt
+    }
+
+    void EventLoop::TimedEventAwaiter::await_suspend( std::coroutine_handle<> h )
+    {
+        handle        = h;
+        event_it      = loop.event_waiters_.insert( loop.event_waiters_.end(), this );
+        waiting_event = true;
+        loop.AddTimer( *this, deadline );
+    }
+
+    void EventLoop::SleepAwaiter::await_suspend( std::coroutine_handle<> h )
+    {
+        handle = h;
+        loop.AddTimer( *this, deadline );
+    }
+
+    void EventLoop::FrameAwaiter::await_suspend( std::coroutine_handle<> h )
+    {
+        handle = h;
+        loop.frame_waiters_.push_back( this );
+
+        // 여러 코루틴이 요청해도 한 프레임으로 합쳐짐
+        Device::RequestFrame();
+    }
+
+    void EventLoop::CursorAwaiter::await_suspend( std::coroutine_handle<> h )
+    {
+        // callback은 Reader 스레드에서 실행되므로, 결과 반영과 재개는 루프 스레드로 넘김
+        // (루프가 먼저 사라지면 posted가 실행되지 않으므로 this, h는 그때까지만 유효하면 됨)
+        std::weak_ptr<Shared> weak = loop.shared_;
+        EventLoop*            owner = &loop;
+
+        Device::Query( TermQuery::CURSOR_POS, [weak, owner, this, h]( const QueryReply& reply ) {
+            std::optional<Coord> pos;
+            if( reply.ok ) pos = reply.cursor;
+
+            if( auto shared = weak.lock() ) {
+                shared->Post( [owner, this, h, pos] {
+                    result = pos;
+                    owner->ready_.push_back( h );
+                } );
+            }
+        }, timeout );
+    }
+
+    // =========================================================================
+    // EventLoop
+    // =========================================================================
+
+    EventLoop::EventLoop( size_t capacity )
+        : shared_  ( std::make_shared<Shared>() )
+        , capacity_( capacity )
+    {
+        shared_->sub = Device::Subscribe( capacity, true );
+    }
+
+    EventLoop::~EventLoop()
+    {
+        // 대기 중인 코루틴 프레임은 roots_와 함께 해제됨 (Waiter 목록은 그 뒤에 쓰이지 않음)
+    }
+
+    void EventLoop::Shared::Post( std::function<void()> fn )
+    {
+        {
+            std::lock_guard<std::mutex> lock( mtx );
+            posted.push_back( std::move( fn ) );
+        }
+
+        // 빈 이벤트로 Wait() 중인 루프를 깨움
+        // (큐가 가득 차서 버려져도, 루프는 쌓인 이벤트를 처리한 뒤 posted를 확인함)
+        sub.Post( Device::Event{} );
+    }
+
+    void EventLoop::Spawn( Task<> task )
+    {
+        if( !task.IsValid() ) return;
+
+        ready_.push_back( task.handle_ );
+        roots_.push_back( std::move( task ) );
+    }
+
+    void EventLoop::Stop( void )
+    {
+        stop_.store( true, std::memory_order_release );
+        shared_->sub.Post( Device::Event{} );
+    }
+
+    void EventLoop::Post( std::function<void()> fn )
+    {
+        shared_->Post( std::move( fn ) );
+    }
+
+    void EventLoop::Run( void )
+    {
+        constexpr size_t BATCH_SIZE = 64;
+
+        while( !stop_.load( std::memory_order_acquire ) )
+        {
+            RunReady();
+            if( roots_.empty() ) break;
+
+            // 가장 가까운 타이머까지만 대기 (타이머가 없으면 이벤트가 올 때까지)
+            int timeout_ms = -1;
+            if( !ready_.empty() ) {
+                timeout_ms = 0;
+            }
+            else if( !timers_.empty() ) {
+                auto wait  = timers_.begin()->first - Clock::now();
+                auto ms    = std::chrono::ceil<std::chrono::milliseconds>( wait ).count();
+                timeout_ms = static_cast<int>( std::max<int64_t>( ms, 0 ) );
+            }
+
+            if( auto event = shared_->sub.WaitFor( std::chrono::milliseconds( timeout_ms ) ) )
+            {
+                Dispatch( std::move( *event ) );
+
+                // 이미 쌓여 있는 이벤트는 대기 없이 함께 처리
+                for( size_t i = 1; i < BATCH_SIZE; ++i ) {
+                    auto more = shared_->sub.Poll();
+                    if( !more ) break;
+                    Dispatch( std::move( *more ) );
+                }
+            }
+
+            RunPosted();
+            FireTimers( Clock::now() );
+        }
+
+        stop_.store( false, std::memory_order_release );
+    }
+
+    void EventLoop::Dispatch( Device::Event&& event )
+    {
+        // Post()/Stop()이 깨우려고 넣은 빈 이벤트
+        if( event.code == DeviceInputCode::NONE ) return;
+
+        if( event.IsFrame() ) {
+            // 기다리는 코루틴이 없으면 버림 (다음 NextFrame()이 새로 요청함)
+            for( Waiter* waiter : frame_waiters_ ) {
+                waiter->event    = event;
+                waiter->received = true;
+                ready_.push_back( waiter->handle );
+            }
+            frame_waiters_.clear();
+            return;
+        }
+
+        if( event_waiters_.empty() ) {
+            // 오래된 것부터 버림 (구독 큐와 같은 용량까지만 보관)
+            if( pending_events_.size() >= capacity_ ) pending_events_.pop_front();
+            pending_events_.push_back( std::move( event ) );
+            return;
+        }
+
+        // 재개된 코루틴이 다시 NextEvent()를 호출해도 이번 이벤트를 또 받지 않도록 목록을 먼저 비움
+        std::list<Waiter*> waiters;
+        waiters.swap( event_waiters_ );
+
+        for( Waiter* waiter : waiters ) {
+            waiter->waiting_event = false;
+            if( waiter->has_timer ) {
+                timers_.erase( waiter->timer_it );
+                waiter->has_timer = false;
+            }
+            waiter->event    = event;
+            waiter->received = true;
+            ready_.push_back( waiter->handle );
+        }
+    }
+
+    void EventLoop::RunReady( void )
+    {
+        while( !ready_.empty() )
+        {
+            auto handle = ready_.front();
+            ready_.pop_front();
+            handle.resume();
+        }
+
+        // 끝난 Task 정리 (예외로 끝났으면 Run() 호출 측으로 전달)
+        std::exception_ptr error;
+        for( auto it = roots_.begin(); it != roots_.end(); ) {
+            if( !it->IsDone() ) { ++it; continue; }
+
+            if( !error ) error = it->handle_.promise().exception;
+            it = roots_.erase( it );
+        }
+        if( error ) std::rethrow_exception( error );
+    }
+
+    void EventLoop::RunPosted( void )
+    {
+        std::vector<std::function<void()>> posted;
+        {
+            std::lock_guard<std::mutex> lock( shared_->mtx );
+            posted.swap( shared_->posted );
+        }
+
+        for( auto& fn : posted ) fn();
+    }
+
+    void EventLoop::AddTimer( Waiter& waiter, TimePoint deadline )
+    {
+        waiter.timer_it  = timers_.emplace( deadline, &waiter );
+        waiter.has_timer = true;
+    }
+
+    void EventLoop::FireTimers( TimePoint now )
+    {
+        while( !timers_.empty() && timers_.begin()->first <= now )
+        {
+            Waiter* waiter = timers_.begin()->second;
+            timers_.erase( timers_.begin() );
+            waiter->has_timer = false;
+
+            // NextEvent( timeout ) : 이벤트 대기 목록에서도 제거 (received == false로 재개)
+            if( waiter->waiting_event ) {
+                event_waiters_.erase( waiter->event_it );
+                waiter->waiting_event = false;
+            }
+            ready_.push_back( waiter->handle );
+        }
+    }
+
+} // namespace cx
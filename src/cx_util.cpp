@@ -1,5 +1,8 @@
 #include "cx_util.hpp"
 
+#include <algorithm> // std::reverse
+#include <limits>    // std::numeric_limits
+
 namespace cx
 {
     // =========================================================================
@@ -44,6 +47,23 @@ namespace cx
         return { 1, 0 }; // Invalid UTF-8, treat as length 1
     }
 
+    /**
+     * @brief GetUtf8CharInfo의 범위 검사 버전 (끝이 잘린 시퀀스는 남은 바이트를 모두 소비)
+     * @param avail str부터 읽을 수 있는 바이트 수
+     */
+    static std::pair<int, uint32_t> GetUtf8CharInfo( const char* str, size_t avail )
+    {
+        unsigned char c = static_cast<unsigned char>( str[0] );
+
+        size_t need = 1;
+        if     ( ( c & 0xE0 ) == 0xC0 ) need = 2;
+        else if( ( c & 0xF0 ) == 0xE0 ) need = 3;
+        else if( ( c & 0xF8 ) == 0xF0 ) need = 4;
+
+        if( need > avail ) return { static_cast<int>( avail ), 0 };
+        return GetUtf8CharInfo( str );
+    }
+
     // =========================================================================
     // Public API Implementation
     // =========================================================================
@@ -106,47 +126,130 @@ namespace cx
         return false;
     }
 
+    /**
+     * @brief 범위 검사로 코드포인트의 표시 너비를 계산합니다. (캐시 미사용)
+     */
+    static uint16_t ComputeCodepointWidth( uint32_t cp )
+    {
+        if( IsZeroWidth( cp ) )         return 0;
+        if( Util::IsDoubleWidth( cp ) ) return 2;
+        return 1;
+    }
+
+    /**
+     * @brief BMP(U+0000 ~ U+FFFF) 코드포인트별 너비 캐시
+     *
+     * @details
+     *   코드포인트당 2비트(0/1/2)로 압축한 16KB 테이블을 최초 사용 시 한 번만 생성합니다.
+     *   이후 너비 조회는 범위 비교 체인 대신 배열 접근 한 번으로 끝납니다.
+     */
+    class WidthCache
+    {
+    public:
+        static const WidthCache& Get( void )
+        {
+            static const WidthCache instance; // C++11 이후 스레드 안전 초기화
+            return instance;
+        }
+
+        uint16_t Lookup( uint32_t cp ) const
+        {
+            return ( table_[cp >> 2] >> ( ( cp & 3 ) * 2 ) ) & 0x3;
+        }
+
+    private:
+        WidthCache()
+        {
+            for( uint32_t cp = 0; cp < 0x10000; ++cp ) {
+                table_[cp >> 2] |= static_cast<uint8_t>( ComputeCodepointWidth( cp ) << ( ( cp & 3 ) * 2 ) );
+            }
+        }
+
+        uint8_t table_[0x10000 / 4] = {};
+    };
+
+    /**
+     * @brief 코드포인트 하나의 표시 너비 (Zero Width=0, Double Width=2, 그 외=1)
+     */
+    static uint16_t GetCodepointWidth( uint32_t cp )
+    {
+        // ASCII는 캐시 조회도 생략
+        if( cp < 0x80 )    return ( cp == 0 ) ? 0 : 1;
+        if( cp < 0x10000 ) return WidthCache::Get().Lookup( cp );
+        return ComputeCodepointWidth( cp );
+    }
+
+    int Util::DecodeUtf8( const char* str, size_t avail, uint32_t& codepoint )
+    {
+        if( avail == 0 ) {
+            codepoint = 0;
+            return 1;
+        }
+        auto [byte_len, cp] = GetUtf8CharInfo( str, avail );
+        codepoint = cp;
+        return byte_len;
+    }
+
+    size_t Util::GetUtf8SeqLength( unsigned char lead )
+    {
+        if( ( lead & 0xE0 ) == 0xC0 ) return 2;
+        if( ( lead & 0xF0 ) == 0xE0 ) return 3;
+        if( ( lead & 0xF8 ) == 0xF0 ) return 4;
+        return 1;
+    }
+
+    void Util::AppendUtf8( std::string& out, uint32_t codepoint )
+    {
+        if( codepoint > 0x10FFFF || ( codepoint >= 0xD800 && codepoint <= 0xDFFF ) ) {
+            codepoint = 0xFFFD; // 유효하지 않은 코드포인트 (서로게이트 포함)
+        }
+
+        if( codepoint < 0x80 ) {
+            out += static_cast<char>( codepoint );
+        }
+        else if( codepoint < 0x800 ) {
+            out += static_cast<char>( 0xC0 | ( codepoint >> 6 ) );
+            out += static_cast<char>( 0x80 | ( codepoint & 0x3F ) );
+        }
+        else if( codepoint < 0x10000 ) {
+            out += static_cast<char>( 0xE0 | ( codepoint >> 12 ) );
+            out += static_cast<char>( 0x80 | ( ( codepoint >> 6 ) & 0x3F ) );
+            out += static_cast<char>( 0x80 | ( codepoint & 0x3F ) );
+        }
+        else {
+            out += static_cast<char>( 0xF0 | ( codepoint >> 18 ) );
+            out += static_cast<char>( 0x80 | ( ( codepoint >> 12 ) & 0x3F ) );
+            out += static_cast<char>( 0x80 | ( ( codepoint >> 6 ) & 0x3F ) );
+            out += static_cast<char>( 0x80 | ( codepoint & 0x3F ) );
+        }
+    }
+
+    int Util::GetCharWidth( uint32_t codepoint )
+    {
+        return GetCodepointWidth( codepoint );
+    }
+
     size_t Util::GetStringWidth( const std::string& str )
     {
         size_t width = 0;
-        size_t i = 0;
-        size_t len = str.length();
 
-        while( i < len ) {
-            // Check ANSI Escape Code
-            if( str[i] == '\033' ) {
-                // '[' 확인
-                if( i + 1 < len && str[i+1] == '[' ) {
-                    size_t j = i + 2;
-                    while( j < len ) {
-                        char c = str[j];
-                        // ANSI 종료 문자 (m, K, H 등)
-                        if( ( c >= 'A' && c <= 'Z' ) || ( c >= 'a' && c <= 'z' ) ) {
-                            j++;
-                            break;
-                        }
-                        j++;
-                    }
-                    i = j; // Skip ANSI sequence
-                    continue;
-                }
-            }
+        AnsiTokenizer tokenizer( str );
+        AnsiTokenizer::Token token;
 
-            // Get Char Info
-            auto [byte_len, codepoint] = GetUtf8CharInfo( &str[i] );
+        while( tokenizer.Next( token ) ) {
+            // 이스케이프 시퀀스는 너비 0
+            if( token.type != AnsiTokenizer::TokenType::TEXT &&
+                token.type != AnsiTokenizer::TokenType::CONTROL ) continue;
 
-            // Zero Width 문자 확인 -> 너비 추가 안 함
-            if ( IsZeroWidth( codepoint ) ) {
-                // 너비 추가 없음
-            }
-            else if( IsDoubleWidth( codepoint ) ) {
-                width += 2;
-            }
-            else {
-                width += 1;
-            }
+            const char* p   = token.raw.data();
+            size_t      len = token.raw.length();
+            size_t      i   = 0;
 
-            i += byte_len;
+            while( i < len ) {
+                auto [byte_len, codepoint] = GetUtf8CharInfo( p + i, len - i );
+                width += GetCodepointWidth( codepoint );
+                i += byte_len;
+            }
         }
 
         return width;
@@ -157,83 +260,624 @@ namespace cx
         std::string res;
         res.reserve( str.length() );
 
-        size_t i = 0;
-        size_t len = str.length();
+        AnsiTokenizer tokenizer( str );
+        AnsiTokenizer::Token token;
 
-        while( i < len ) {
-            if( str[i] == '\033' ) {
-                if( i + 1 < len && str[i+1] == '[' ) {
-                    size_t j = i + 2;
-                    while( j < len ) {
-                        char c = str[j];
-                        if( ( c >= 'A' && c <= 'Z' ) || ( c >= 'a' && c <= 'z' ) ) {
-                            j++;
-                            break;
-                        }
-                        j++;
-                    }
-                    i = j;
-                    continue;
-                }
+        while( tokenizer.Next( token ) ) {
+            if( token.type == AnsiTokenizer::TokenType::TEXT ||
+                token.type == AnsiTokenizer::TokenType::CONTROL ) {
+                res.append( token.raw.data(), token.raw.length() );
             }
-            res += str[i];
-            i++;
         }
         return res;
     }
 
-    std::vector<std::string> Util::SplitStringByWidth( const std::string& str, size_t max_width )
+    std::vector<std::string> Util::SplitStringByWidth( const std::string& str, size_t max_width, WrapMode mode )
+    {
+        std::vector<TextCluster> clusters;
+        BuildClusters( str, clusters );
+
+        std::vector<TextLine> lines;
+        BreakLines( clusters, max_width, lines, mode );
+
+        std::vector<std::string> result;
+        result.reserve( lines.size() );
+
+        for( const auto& line : lines ) {
+            if( line.first == line.last ) {
+                result.emplace_back();
+                continue;
+            }
+            size_t begin = clusters[line.first].offset;
+            size_t end   = clusters[line.last - 1].offset + clusters[line.last - 1].bytes;
+            result.emplace_back( str, begin, end - begin );
+        }
+
+        return result;
+    }
+
+    // =========================================================================
+    // Line Breaking (Simplified UAX #14)
+    // =========================================================================
+
+    /**
+     * @brief 코드포인트의 줄바꿈 분류를 반환합니다.
+     * @note  UAX #14의 전체 분류 대신 터미널 UI에 필요한 부분만 다룹니다.
+     */
+    static BreakClass GetBreakClass( uint32_t cp )
     {
-        std::vector<std::string> lines;
-        std::string current_line;
-        size_t current_width = 0;
+        switch( cp )
+        {
+            // 강제 줄바꿈 (LF, VT, FF, CR, LS, PS)
+            case 0x0A: case 0x0B: case 0x0C: case 0x0D: case 0x2028: case 0x2029:
+                return BreakClass::BK;
+
+            case ' ': case '\t':
+                return BreakClass::SP;
+
+            // NBSP, Figure Space, Narrow NBSP, Word Joiner
+            case 0x00A0: case 0x2007: case 0x202F: case 0x2060:
+                return BreakClass::GL;
+
+            // Hyphen-Minus, Soft Hyphen, Hyphen, En Dash
+            case '-': case 0x00AD: case 0x2010: case 0x2013:
+                return BreakClass::BA;
+
+            // 여는 괄호 (ASCII, CJK, 전각)
+            case '(': case '[': case '{':
+            case 0x3008: case 0x300A: case 0x300C: case 0x300E: case 0x3010:
+            case 0xFF08: case 0xFF3B: case 0xFF5B:
+                return BreakClass::OP;
+
+            // 닫는 괄호 및 구두점 (ASCII, CJK, 전각)
+            case ')': case ']': case '}': case ',': case '.': case ';': case ':': case '!': case '?':
+            case 0x3001: case 0x3002: case 0x3009: case 0x300B: case 0x300D: case 0x300F: case 0x3011:
+            case 0xFF01: case 0xFF09: case 0xFF0C: case 0xFF0E: case 0xFF1A: case 0xFF1B: case 0xFF1F:
+            case 0xFF3D: case 0xFF5D:
+                return BreakClass::CL;
+
+            default:
+                break;
+        }
+
+        if( Util::IsDoubleWidth( cp ) ) return BreakClass::ID;
+        return BreakClass::AL;
+    }
+
+    /**
+     * @brief 두 클러스터 사이(prev | cur)에서 줄바꿈이 가능한지 판단합니다.
+     * @param prev2 prev 바로 앞의 분류 (단어 앞 하이픈 판별용)
+     */
+    static bool CanBreakBetween( BreakClass prev2, BreakClass prev, BreakClass cur )
+    {
+        // 공백, 닫는 괄호/구두점 앞에서는 자르지 않음 (LB7, LB13)
+        if( cur == BreakClass::SP || cur == BreakClass::CL || cur == BreakClass::BK ) return false;
+
+        // 여는 괄호 뒤, NBSP 앞뒤에서는 자르지 않음 (LB12, LB14)
+        if( prev == BreakClass::OP || prev == BreakClass::GL || cur == BreakClass::GL ) return false;
+
+        // 공백 뒤에서는 자름 (LB18)
+        if( prev == BreakClass::SP ) return true;
+
+        // 하이픈 뒤에서는 자르되, "-option" 처럼 단어 앞에 붙은 하이픈은 제외 (LB20.1, LB21)
+        if( prev == BreakClass::BA ) return prev2 != BreakClass::SP && prev2 != BreakClass::BK;
+
+        // 표의 문자(한글, 한자 등)는 앞뒤 모두 자를 수 있음 (LB31)
+        if( prev == BreakClass::ID || cur == BreakClass::ID ) return true;
+
+        return false;
+    }
+
+    void Util::BuildClusters( std::string_view str, std::vector<TextCluster>& out )
+    {
+        out.clear();
+
+        // 문자열 시작은 강제 줄바꿈 직후와 동일하게 취급
+        BreakClass prev  = BreakClass::BK;
+        BreakClass prev2 = BreakClass::BK;
+        bool join_next = false; // ZWJ 직후의 문자는 앞 클러스터에 합침
+        size_t skip_to = 0;     // CR LF 처리 시 이미 소비한 위치
 
-        size_t i = 0;
         size_t len = str.length();
 
-        while( i < len ) {
-            // 1. Handle ANSI Code (Copy but don't count width)
-            if( str[i] == '\033' ) {
-                if( i + 1 < len && str[i+1] == '[' ) {
-                    size_t start = i;
-                    size_t j = i + 2;
-                    while( j < len ) {
-                        char c = str[j];
-                        if( ( c >= 'A' && c <= 'Z' ) || ( c >= 'a' && c <= 'z' ) ) {
-                            j++;
-                            break;
-                        }
-                        j++;
-                    }
-                    // Add ANSI code to current line directly
-                    current_line.append( str, start, j - start );
-                    i = j;
+        AnsiTokenizer tokenizer( str );
+        AnsiTokenizer::Token token;
+
+        while( tokenizer.Next( token ) ) {
+            size_t begin = static_cast<size_t>( token.raw.data() - str.data() );
+            size_t end   = begin + token.raw.length();
+
+            // 1. 이스케이프 시퀀스: 너비 0, 줄바꿈 판단에서 투명
+            if( token.type != AnsiTokenizer::TokenType::TEXT &&
+                token.type != AnsiTokenizer::TokenType::CONTROL )
+            {
+                out.push_back( { (uint32_t)begin, (uint32_t)( end - begin ), 0, BreakClass::ANSI, false } );
+                continue;
+            }
+
+            // 2. 텍스트 런 / 제어 문자를 글자 단위로 분석
+            size_t i = std::max( begin, skip_to );
+            while( i < end ) {
+                auto [byte_len, codepoint] = GetUtf8CharInfo( &str[i], end - i );
+
+                // CR LF는 하나의 강제 줄바꿈으로 취급 (LF는 다음 토큰이므로 건너뜀)
+                if( codepoint == '\r' && i + 1 < len && str[i+1] == '\n' ) {
+                    byte_len = 2;
+                    skip_to  = i + 2;
+                }
+
+                uint16_t width = GetCodepointWidth( codepoint );
+
+                // 3. 결합 문자는 앞 클러스터에 합침 (너비는 GetStringWidth와 동일하게 누적)
+                if( ( width == 0 || join_next ) && !out.empty() &&
+                    out.back().cls != BreakClass::ANSI && out.back().cls != BreakClass::BK )
+                {
+                    TextCluster& back = out.back();
+                    back.bytes  = (uint32_t)( i + byte_len - back.offset );
+                    back.width += width;
+                    join_next   = ( codepoint == 0x200D );
+                    i += byte_len;
                     continue;
                 }
+
+                // 4. 새 클러스터
+                TextCluster cluster { (uint32_t)i, (uint32_t)byte_len, width, GetBreakClass( codepoint ), false };
+
+                if( cluster.cls == BreakClass::BK ) cluster.width = 0;
+                else cluster.break_before = CanBreakBetween( prev2, prev, cluster.cls );
+
+                out.push_back( cluster );
+
+                prev2     = prev;
+                prev      = cluster.cls;
+                join_next = ( codepoint == 0x200D );
+                i += byte_len;
             }
+        }
+    }
 
-            // 2. Handle Character
-            auto [byte_len, codepoint] = GetUtf8CharInfo( &str[i] );
-            size_t char_width = IsDoubleWidth( codepoint ) ? 2 : 1;
+    /**
+     * @brief [first, last) 범위를 한 줄로 추가합니다. (줄 끝 공백은 제외)
+     * @param width 줄 끝 공백을 포함한 너비
+     */
+    static void EmitLine( const std::vector<TextCluster>& clusters, size_t first, size_t last,
+                          size_t width, std::vector<TextLine>& out )
+    {
+        while( last > first && clusters[last - 1].cls == BreakClass::SP ) {
+            width -= clusters[last - 1].width;
+            last--;
+        }
+        out.push_back( { (uint32_t)first, (uint32_t)last, (uint32_t)width } );
+    }
+
+    /**
+     * @brief 한 문단 [begin, end)을 Greedy 방식으로 줄바꿈합니다. (강제 줄바꿈 없음)
+     */
+    static void BreakGreedy( const std::vector<TextCluster>& clusters, size_t begin, size_t end,
+                             size_t limit, std::vector<TextLine>& out )
+    {
+        constexpr size_t npos = static_cast<size_t>( -1 );
+
+        size_t start = begin;
+        size_t width = 0;           // 현재 줄 너비 (줄 끝 공백 포함)
+        size_t trail = 0;           // 현재 줄 끝 공백 너비
+        size_t brk   = npos;        // 마지막 줄바꿈 가능 위치
+        size_t width_since_brk = 0; // brk 이후의 너비
+
+        for( size_t i = begin; i < end; ++i ) {
+            const TextCluster& c = clusters[i];
+
+            if( c.cls == BreakClass::ANSI ) continue;
+
+            // 공백은 줄 끝에 매달릴 수 있으므로 넘침 검사를 하지 않음
+            if( c.cls == BreakClass::SP ) {
+                width += c.width;
+                trail += c.width;
+                if( brk != npos ) width_since_brk += c.width;
+                continue;
+            }
+
+            if( c.break_before && i > start ) {
+                brk = i;
+                width_since_brk = 0;
+            }
 
-            // 3. Wrap Check
-            if( current_width + char_width > max_width ) {
-                lines.push_back( current_line );
-                current_line.clear();
-                current_width = 0;
+            if( width + c.width > limit && width > trail ) {
+                // 1. 마지막 줄바꿈 가능 위치에서 자름
+                if( brk != npos && brk > start ) {
+                    EmitLine( clusters, start, brk, width - width_since_brk, out );
+                    if( brk == i ) trail = 0;
+                    start = brk;
+                    width = width_since_brk;
+                    brk   = npos;
+                }
+                // 2. 한 줄보다 긴 단어는 글자 단위로 자름 (Emergency Break)
+                if( width + c.width > limit && width > trail ) {
+                    EmitLine( clusters, start, i, width, out );
+                    start = i;
+                    width = 0;
+                    trail = 0;
+                }
             }
 
-            // 4. Append
-            current_line.append( str, i, byte_len );
-            current_width += char_width;
-            i += byte_len;
+            width += c.width;
+            trail  = 0;
+            if( brk != npos ) width_since_brk += c.width;
         }
 
-        if( !current_line.empty() ) {
-            lines.push_back( current_line );
+        EmitLine( clusters, start, end, width, out );
+    }
+
+    /**
+     * @brief 한 문단 [begin, end)을 Minimum Raggedness 방식으로 줄바꿈합니다.
+     * @return 한 줄보다 긴 단어가 있어 적용할 수 없으면 false (호출 측에서 Greedy로 대체)
+     *
+     * @details
+     *   cost(j) = min{ cost(k) + (limit - width(k, j))^2 } 의 동적 계획법이며,
+     *   마지막 줄의 여백은 비용에 포함하지 않습니다.
+     *   k를 j에서 가까운 순서로 보다가 한 줄 너비를 넘으면 즉시 멈추므로
+     *   후보 검사 횟수는 한 줄에 들어가는 후보 수로 제한됩니다.
+     */
+    static bool BreakMinRagged( const std::vector<TextCluster>& clusters, size_t begin, size_t end,
+                                size_t limit, std::vector<TextLine>& out )
+    {
+        // 호출 간 재사용되는 작업 공간 (스레드별)
+        thread_local std::vector<uint32_t> prefix; // prefix[i] : [begin, i) 너비 합
+        thread_local std::vector<uint32_t> trail;  // trail[i]  : i 직전 공백 너비
+        thread_local std::vector<uint32_t> cand;   // 줄 시작 후보 인덱스 (+ 마지막에 end)
+        thread_local std::vector<uint64_t> cost;
+        thread_local std::vector<uint32_t> from;
+
+        constexpr uint64_t INF = std::numeric_limits<uint64_t>::max();
+
+        size_t count = end - begin;
+        prefix.resize( count + 1 );
+        trail.resize( count + 1 );
+        cand.clear();
+
+        prefix[0] = 0;
+        trail[0]  = 0;
+        cand.push_back( (uint32_t)begin );
+
+        for( size_t i = begin; i < end; ++i ) {
+            const TextCluster& c = clusters[i];
+            size_t r = i - begin;
+
+            prefix[r + 1] = prefix[r] + c.width;
+            if     ( c.cls == BreakClass::SP   ) trail[r + 1] = trail[r] + c.width;
+            else if( c.cls == BreakClass::ANSI ) trail[r + 1] = trail[r];
+            else                                 trail[r + 1] = 0;
+
+            if( i > begin && c.break_before && c.cls != BreakClass::ANSI )
+                cand.push_back( (uint32_t)i );
         }
+        cand.push_back( (uint32_t)end );
+
+        cost.assign( cand.size(), INF );
+        from.assign( cand.size(), 0 );
+        cost[0] = 0;
+
+        for( size_t j = 1; j < cand.size(); ++j ) {
+            size_t rj      = cand[j] - begin;
+            bool   is_last = ( j + 1 == cand.size() );
+
+            for( size_t k = j; k-- > 0; ) {
+                size_t rk = cand[k] - begin;
+                size_t line_width = prefix[rj] - trail[rj] - prefix[rk];
+
+                if( line_width > limit ) break;
+                if( cost[k] == INF ) continue;
+
+                uint64_t slack = limit - line_width;
+                uint64_t total = cost[k] + ( is_last ? 0 : slack * slack );
+                if( total < cost[j] ) {
+                    cost[j] = total;
+                    from[j] = (uint32_t)k;
+                }
+            }
+        }
+
+        if( cost.back() == INF ) return false;
+
+        // 역추적: 뒤에서부터 줄을 추가한 후 뒤집음
+        size_t first_line = out.size();
+        for( size_t j = cand.size() - 1; j > 0; j = from[j] ) {
+            size_t k  = from[j];
+            size_t rk = cand[k] - begin;
+            size_t rj = cand[j] - begin;
+            EmitLine( clusters, cand[k], cand[j], prefix[rj] - prefix[rk], out );
+        }
+        std::reverse( out.begin() + first_line, out.end() );
+
+        return true;
+    }
+
+    void Util::BreakLines( const std::vector<TextCluster>& clusters, size_t max_width,
+                           std::vector<TextLine>& out, WrapMode mode )
+    {
+        out.clear();
+
+        // 너비 0은 의미가 없으므로 최소 1칸으로 취급
+        size_t limit = std::max<size_t>( max_width, 1 );
+
+        auto BreakParagraph = [&]( size_t begin, size_t end ) {
+            if( mode == WrapMode::MIN_RAGGED && BreakMinRagged( clusters, begin, end, limit, out ) )
+                return;
+            BreakGreedy( clusters, begin, end, limit, out );
+        };
+
+        // 강제 줄바꿈(BK) 단위로 문단을 나누어 처리
+        size_t para_begin = 0;
+        for( size_t i = 0; i < clusters.size(); ++i ) {
+            if( clusters[i].cls == BreakClass::BK ) {
+                BreakParagraph( para_begin, i );
+                para_begin = i + 1;
+            }
+        }
+        if( para_begin < clusters.size() ) {
+            BreakParagraph( para_begin, clusters.size() );
+        }
+    }
+
+    // =========================================================================
+    // AnsiTokenizer (Paul Williams VT Parser State Machine)
+    // =========================================================================
+
+    void AnsiTokenizer::Feed( std::string_view input )
+    {
+        input_     = input;
+        pos_       = 0;
+        seq_start_ = 0;
+    }
+
+    void AnsiTokenizer::Reset( void )
+    {
+        state_      = State::GROUND;
+        st_pending_ = false;
+        Clear();
+        str_buf_.clear();
+    }
+
+    void AnsiTokenizer::Clear( void )
+    {
+        // str_buf_는 직전에 반환한 토큰의 payload가 가리키고 있으므로
+        // 새 문자열 상태에 진입할 때 비움
+        seq_ = Token {};
+    }
 
-        return lines;
+    void AnsiTokenizer::Collect( char c )
+    {
+        // Private Marker는 파라미터보다 먼저 오는 '<' '=' '>' '?'
+        if( c >= 0x3C && c <= 0x3F ) {
+            seq_.prefix = c;
+            return;
+        }
+        if     ( seq_.intermediate[0] == 0 ) seq_.intermediate[0] = c;
+        else if( seq_.intermediate[1] == 0 ) seq_.intermediate[1] = c;
+    }
+
+    void AnsiTokenizer::AddParam( char c )
+    {
+        if( seq_.param_count == 0 ) {
+            seq_.param_count = 1;
+            seq_.params[0]   = -1;
+        }
+
+        if( c == ';' || c == ':' ) {
+            if( seq_.param_count >= MAX_PARAMS ) return; // 초과분은 무시
+            seq_.params[seq_.param_count] = -1;
+            if( c == ':' ) seq_.sub_mask |= static_cast<uint16_t>( 1u << seq_.param_count );
+            seq_.param_count++;
+            return;
+        }
+
+        int& value = seq_.params[seq_.param_count - 1];
+        value = std::min( ( value < 0 ? 0 : value ) * 10 + ( c - '0' ), 65535 );
+    }
+
+    void AnsiTokenizer::Put( char c )
+    {
+        if( str_buf_.length() < MAX_STRING ) str_buf_ += c;
+    }
+
+    bool AnsiTokenizer::Emit( Token& token, TokenType type, char final_ch, size_t end )
+    {
+        token          = seq_;
+        token.type     = type;
+        token.final_ch = final_ch;
+        token.raw      = input_.substr( seq_start_, end - seq_start_ );
+        if( type == TokenType::OSC || type == TokenType::DCS ) token.payload = str_buf_;
+        return true;
+    }
+
+    bool AnsiTokenizer::Next( Token& token )
+    {
+        const size_t len = input_.length();
+
+        while( pos_ < len ) {
+            const size_t        at = pos_;
+            const unsigned char b  = static_cast<unsigned char>( input_[pos_] );
+
+            // -----------------------------------------------------------------
+            // Ground: 텍스트 런은 한 번에 잘라서 반환 (Fast Path)
+            // -----------------------------------------------------------------
+            if( state_ == State::GROUND && b >= 0x20 && b != 0x7F ) {
+                while( pos_ < len ) {
+                    unsigned char c = static_cast<unsigned char>( input_[pos_] );
+                    if( c < 0x20 || c == 0x7F ) break;
+                    pos_++;
+                }
+                token      = Token {};
+                token.type = TokenType::TEXT;
+                token.raw  = input_.substr( at, pos_ - at );
+                return true;
+            }
+
+            pos_++;
+
+            // 문자열 상태: ESC는 ST의 시작으로 간주
+            const bool is_string = ( state_ == State::OSC_STRING || state_ == State::DCS_PASSTHROUGH ||
+                                     state_ == State::DCS_IGNORE || state_ == State::SOS_PM_APC_STRING );
+
+            // DCS 헤더 및 문자열 상태: C0 제어 문자를 실행하지 않음
+            const bool ignore_c0 = is_string || state_ == State::DCS_ENTRY ||
+                                   state_ == State::DCS_PARAM || state_ == State::DCS_INTERMEDIATE;
+
+            // -----------------------------------------------------------------
+            // Anywhere Transitions
+            // -----------------------------------------------------------------
+
+            // CAN, SUB: 진행 중인 시퀀스 취소
+            if( b == 0x18 || b == 0x1A ) {
+                state_      = State::GROUND;
+                st_pending_ = false;
+                seq_start_  = at;
+                Clear();
+                return Emit( token, TokenType::CONTROL, static_cast<char>( b ), pos_ );
+            }
+
+            // ESC: 새 시퀀스 시작 (문자열 안이라면 ST의 첫 바이트)
+            if( b == 0x1B ) {
+                State prev_state = state_;
+                bool  emitted    = false;
+
+                if( prev_state == State::OSC_STRING ) {
+                    emitted = Emit( token, TokenType::OSC, 0, at );
+                }
+                else if( prev_state == State::DCS_PASSTHROUGH ) {
+                    emitted = Emit( token, TokenType::DCS, seq_.final_ch, at );
+                }
+
+                st_pending_ = is_string;
+                state_      = State::ESCAPE;
+                seq_start_  = at;
+                Clear();
+
+                if( emitted ) return true;
+                continue;
+            }
+
+            // C0 제어 문자: 시퀀스 도중이라도 즉시 실행
+            if( b < 0x20 && !ignore_c0 ) {
+                token          = Token {};
+                token.type     = TokenType::CONTROL;
+                token.final_ch = static_cast<char>( b );
+                token.raw      = input_.substr( at, 1 );
+                return true;
+            }
+
+            const char c = static_cast<char>( b );
+
+            switch( state_ )
+            {
+                case State::GROUND:
+                    // 여기 도달하는 것은 DEL(0x7F) 뿐 -> 무시
+                    break;
+
+                case State::ESCAPE:
+                    if( b == 0x7F ) break;
+
+                    // ST (ESC \) : 문자열 종료 -> 이미 처리됨
+                    if( c == '\\' && st_pending_ ) {
+                        st_pending_ = false;
+                        state_      = State::GROUND;
+                        break;
+                    }
+                    st_pending_ = false;
+
+                    if     ( b >= 0x20 && b <= 0x2F ) { Collect( c ); state_ = State::ESCAPE_INTERMEDIATE; }
+                    else if( c == '[' ) { state_ = State::CSI_ENTRY; }
+                    else if( c == ']' ) { str_buf_.clear(); state_ = State::OSC_STRING; }
+                    else if( c == 'P' ) { state_ = State::DCS_ENTRY; }
+                    else if( c == 'X' || c == '^' || c == '_' ) { state_ = State::SOS_PM_APC_STRING; }
+                    else if( b >= 0x30 && b <= 0x7E ) {
+                        state_ = State::GROUND;
+                        return Emit( token, TokenType::ESC, c, pos_ );
+                    }
+                    else {
+                        // 8-bit 바이트: 시퀀스를 버리고 텍스트로 다시 처리
+                        state_ = State::GROUND;
+                        pos_   = at;
+                    }
+                    break;
+
+                case State::ESCAPE_INTERMEDIATE:
+                    if     ( b >= 0x20 && b <= 0x2F ) { Collect( c ); }
+                    else if( b >= 0x30 && b <= 0x7E ) {
+                        state_ = State::GROUND;
+                        return Emit( token, TokenType::ESC, c, pos_ );
+                    }
+                    break;
+
+                case State::CSI_ENTRY:
+                case State::CSI_PARAM:
+                    if     ( ( c >= '0' && c <= '9' ) || c == ';' || c == ':' ) { AddParam( c ); state_ = State::CSI_PARAM; }
+                    else if( b >= 0x3C && b <= 0x3F ) {
+                        if( state_ == State::CSI_ENTRY ) { Collect( c ); state_ = State::CSI_PARAM; }
+                        else                             { state_ = State::CSI_IGNORE; }
+                    }
+                    else if( b >= 0x20 && b <= 0x2F ) { Collect( c ); state_ = State::CSI_INTERMEDIATE; }
+                    else if( b >= 0x40 && b <= 0x7E ) {
+                        state_ = State::GROUND;
+                        return Emit( token, TokenType::CSI, c, pos_ );
+                    }
+                    break;
+
+                case State::CSI_INTERMEDIATE:
+                    if     ( b >= 0x20 && b <= 0x2F ) { Collect( c ); }
+                    else if( b >= 0x30 && b <= 0x3F ) { state_ = State::CSI_IGNORE; }
+                    else if( b >= 0x40 && b <= 0x7E ) {
+                        state_ = State::GROUND;
+                        return Emit( token, TokenType::CSI, c, pos_ );
+                    }
+                    break;
+
+                case State::CSI_IGNORE:
+                    if( b >= 0x40 && b <= 0x7E ) state_ = State::GROUND;
+                    break;
+
+                case State::DCS_ENTRY:
+                case State::DCS_PARAM:
+                    if( b < 0x20 || b == 0x7F ) break;
+                    if     ( ( c >= '0' && c <= '9' ) || c == ';' || c == ':' ) { AddParam( c ); state_ = State::DCS_PARAM; }
+                    else if( b >= 0x3C && b <= 0x3F ) {
+                        if( state_ == State::DCS_ENTRY ) { Collect( c ); state_ = State::DCS_PARAM; }
+                        else                             { state_ = State::DCS_IGNORE; }
+                    }
+                    else if( b >= 0x20 && b <= 0x2F ) { Collect( c ); state_ = State::DCS_INTERMEDIATE; }
+                    else if( b >= 0x40 && b <= 0x7E ) { seq_.final_ch = c; str_buf_.clear(); state_ = State::DCS_PASSTHROUGH; }
+                    break;
+
+                case State::DCS_INTERMEDIATE:
+                    if( b < 0x20 || b == 0x7F ) break;
+                    if     ( b >= 0x20 && b <= 0x2F ) { Collect( c ); }
+                    else if( b >= 0x30 && b <= 0x3F ) { state_ = State::DCS_IGNORE; }
+                    else if( b >= 0x40 && b <= 0x7E ) { seq_.final_ch = c; str_buf_.clear(); state_ = State::DCS_PASSTHROUGH; }
+                    break;
+
+                case State::DCS_PASSTHROUGH:
+                    if( b != 0x7F ) Put( c );
+                    break;
+
+                case State::OSC_STRING:
+                    // BEL 종료 (xterm 방식)
+                    if( b == 0x07 ) {
+                        state_ = State::GROUND;
+                        return Emit( token, TokenType::OSC, 0, pos_ );
+                    }
+                    if( b >= 0x20 ) Put( c );
+                    break;
+
+                case State::DCS_IGNORE:
+                case State::SOS_PM_APC_STRING:
+                    // ST가 올 때까지 무시
+                    break;
+            }
+        }
+
+        // 시퀀스가 다음 입력 조각으로 이어지는 경우, raw는 다음 조각의 처음부터 가리킴
+        seq_start_ = 0;
+        return false;
     }
 
 } // namespace cx
\ No newline at end of file